@@ -1,29 +1,86 @@
 #include "game_modes.h"
+#include "wordle_alloc_counter.h"
+#include "wordle_batch.h"
 #include "wordle_buffer.h"
 #include "wordle_checker.h"
 #include "wordle_helpers.h"
+#include "wordle_openers.h"
 #include "wordle_rules.h"
 #include "wordle_selector.h"
 #include "wordle_solver.h"
+#include "wordle_state_cache.h"
+#include "wordle_transposition_table.h"
+#include "wordle_thread_pool.h"
 #include "wordlist_wordle_solver.h"
 
-#include <future>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
 #include <memory>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
 
 using namespace std;
 
+namespace WORDLE_NAMESPACE {
+
+
+void WordleSweepStats::print(size_t successes, ostream& os) const {
+    if (successes > 0) {
+        os << "average guesses: " << std::setprecision(6) << (static_cast<double>(successGuesses)/static_cast<double>(successes)) << endl;
+    }
+    if (numSelections > 0) {
+        os << "average guess latency: " << std::setprecision(4) << (static_cast<double>(selectionNanos)/static_cast<double>(numSelections)/1000.0) << "us" << endl;
+    }
+    if (isCountingHeapAllocs()) {
+        os << "steady-state heap allocations: " << steadyStateAllocs << endl;
+    }
+    os << "processResult latency by candidates:" << endl;
+    for (size_t bucket = 0; bucket < NUM_CANDIDATE_BUCKETS; bucket++) {
+        if (processCalls[bucket] == 0) {
+            continue;
+        }
+        size_t low = (bucket == 0) ? 0 : (size_t(1) << (bucket - 1));
+        size_t high = (bucket == 0) ? 0 : (size_t(1) << bucket) - 1;
+        os << " " << std::setw(12) << (to_string(low) + "-" + to_string(high)) << ": "
+             << std::setprecision(4) << (static_cast<double>(processNanos[bucket])/static_cast<double>(processCalls[bucket])/1000.0)
+             << "us (" << processCalls[bucket] << " calls)" << endl;
+    }
+}
+
+void WordleSweepStats::addProcessResult(size_t numCandidates, size_t nanos) {
+    size_t bucket = std::min<size_t>(std::bit_width(numCandidates), NUM_CANDIDATE_BUCKETS - 1);
+    processCalls[bucket]++;
+    processNanos[bucket] += nanos;
+}
 
 // Runs one iteration of the Wordle game with automated solver & checker.
-bool runOneGame(const string& solverType, const string& answer, size_t idx, shared_ptr<WordleBuffer> wb) {
-    auto solver = Helpers::createWordleSolver(solverType);
+bool runOneGame(const string& solverType, const string& selectorType, const string& answer, size_t idx, shared_ptr<WordleBuffer> wb, WordleSweepStats* stats, bool isHardMode) {
+    auto solver = Helpers::createWordleSolver(solverType, selectorType, isHardMode);
+    return runOneGame(solver.get(), answer, idx, wb, stats);
+}
+
+// Same as above, reusing an existing solver. Solver must be fresh or reset().
+bool runOneGame(WordleSolverImpl* solver, const string& answer, size_t idx, shared_ptr<WordleBuffer> wb, WordleSweepStats* stats) {
     auto checker = WordleChecker();
     checker.setAnswer(answer);
+    checker.setHardMode(solver->isHardMode());
 
     size_t numGuesses = 0;
-    auto guess = WordleGuess(solver->makeInitialGuess(wb, idx));
+    auto timedGuess = [&](auto makeGuess) -> string {
+        auto start = chrono::steady_clock::now();
+        string guessStr = makeGuess();
+        if (stats) {
+            stats->numSelections++;
+            stats->selectionNanos += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        }
+        return guessStr;
+    };
+    auto guess = WordleGuess(timedGuess([&]() { return solver->makeInitialGuess(wb, idx); }));
     bool result = checker.check(guess, numGuesses);
     do {
         if (result) {
@@ -33,106 +90,376 @@ bool runOneGame(const string& solverType, const string& answer, size_t idx, shar
                 }
                 break;
             }
-            solver->processResult(guess);
+            if (stats) {
+                size_t numCandidates = solver->getNumCandidates();
+                auto start = chrono::steady_clock::now();
+                solver->processResult(guess);
+                stats->addProcessResult(numCandidates, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+            } else {
+                solver->processResult(guess);
+            }
         }
 
-        guess = WordleGuess(solver->makeSubsequentGuess(numGuesses, wb, idx));
+        guess = WordleGuess(timedGuess([&]() { return solver->makeSubsequentGuess(numGuesses, wb, idx); }));
         result = checker.check(guess, numGuesses);
     } while (numGuesses < MAX_GUESSES);
 
-    if (numGuesses >= MAX_GUESSES && guess != CorrectWordleGuess) {
-        wb->write("failure," + to_string(solver->getNumCandidates()) + "," + to_string(numGuesses) + "," + answer, idx, /*newline=*/true);
-        return false;
+    // written piecewise, the whole line is past the small-string buffer
+    bool isSuccess = !(numGuesses >= MAX_GUESSES && guess != CorrectWordleGuess);
+    wb->write(isSuccess ? "success," : "failure,", idx);
+    wb->write(to_string(solver->getNumCandidates()) + ",", idx);
+    wb->write(to_string(numGuesses) + ",", idx);
+    wb->write(answer, idx, /*newline=*/true);
+    wb->finishLine(idx);
+    if (isSuccess && stats) stats->successGuesses += numGuesses;
+    return isSuccess;
+}
+
+// Resets `solver` and plays one game. Once warm (not the solver's first game), any heap
+// allocation counts against the sweep: the game should only reuse what earlier games allocated.
+bool runReusedGame(WordleSolverImpl* solver, bool isWarm, const string& answer, size_t idx, shared_ptr<WordleBuffer> wb, WordleSweepStats* stats) {
+    size_t allocsBefore = getThreadHeapAllocs();
+    solver->reset();
+    bool result = runOneGame(solver, answer, idx, wb, stats);
+    if (isWarm && stats) {
+        stats->steadyStateAllocs += getThreadHeapAllocs() - allocsBefore;
     }
+    return result;
+}
 
-    wb->write("success," + to_string(solver->getNumCandidates()) + "," + to_string(numGuesses) + "," + answer, idx, /*newline=*/true);
-    return true;
+// Output rows a sweep keeps in flight per worker: a game slower than the rest holds back the output,
+//  the others run ahead of it by this much before they wait
+static const size_t SWEEP_WINDOW_PER_WORKER = 4;
+
+// Plays game(workerIdx, idx) for every idx in [0, numGames) on `pool`. Workers take the next game
+//  in index order, as the batch workers do, so the rows in flight fit a window of a few per worker.
+template <typename GameFn>
+void runGamesInOrder(WordleThreadPool& pool, size_t numGames, const GameFn& game) {
+    atomic<size_t> nextGame{0};
+    pool.run(pool.getNumWorkers(), 1, [&](size_t workerIdx, size_t unused_begin, size_t unused_end) {
+        size_t idx;
+        while ((idx = nextGame.fetch_add(1)) < numGames) {
+            game(workerIdx, idx);
+        }
+    });
 }
 
 // Runs automated solver across entire dictionary on multiple threads to speed up time to completion.
-void runAllWordsMultiThreaded(const string& solverType) {
-    vector<string> words = Helpers::getDictionary();
+void runAllWordsMultiThreaded(const string& solverType, const string& selectorType, bool isHardMode) {
+    const vector<string>& words = Helpers::getDictionary();
     size_t successes = 0;
-    auto wb = make_shared<WordleBuffer>();
+    WordleSweepStats stats;
+    auto pool = WordleThreadPool();
+    auto wb = make_shared<WordleBuffer>(&cout, pool.getNumWorkers() * SWEEP_WINDOW_PER_WORKER);
     wb->write("guess1cands,guess2cands,guess3cands,guess4cands,guess5cands,guess6cands,result,words_left,num_guesses,answer", 0, /*newline=*/ true);
+    wb->finishLine(0);
 
-    auto threads = vector<future<bool>>();
-    for (size_t count = 0; count < words.size(); count++) {
-        threads.push_back(async(launch::async, runOneGame, solverType, words[count], count+1, wb));
-    }
-
-    for (size_t i = 0; i < threads.size(); i++) {
-        if (threads[i].valid()) {
-            successes = threads[i].get() ? successes+1 : successes;
+    // one solver per worker, loaded once and reset between games, every one reusing the states the others reached
+    auto solvers = vector<unique_ptr<WordleSolverImpl>>(pool.getNumWorkers());
+    auto cache = make_shared<WordleStateCache>(WordleDictionary::getAnswers());
+    auto table = make_shared<WordleTranspositionTable>();
+    auto results = vector<char>(words.size(), false);
+    auto start = chrono::steady_clock::now();
+    runGamesInOrder(pool, words.size(), [&](size_t workerIdx, size_t i) {
+        auto& solver = solvers[workerIdx];
+        bool isWarm = solver != nullptr;
+        if (!solver) {
+            solver = Helpers::createWordleSolver(solverType, selectorType, isHardMode);
+            solver->setStateCache(cache);
+            solver->setTranspositionTable(table);
         }
+        results[i] = runReusedGame(solver.get(), isWarm, words[i], i+1, wb, &stats);
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (auto& result : results) {
+        successes = result ? successes+1 : successes;
     }
 
-    cout << wb->read() << endl;
+    cout << endl;
     cout << successes << "/" << words.size() << "=" << std::setprecision(4) << (static_cast<double>(successes)/static_cast<double>(words.size())) << endl;
+    stats.print(successes);
+    cache->print();
+    table->print();
+    cout << "games per second: " << std::setprecision(4) << (static_cast<double>(words.size())/seconds) << endl;
     cout << "done." << endl;
 }
 
 // Runs automated solver across entire dictionary.
-void runAllWords(const string& solverType) {
-    vector<string> words = Helpers::getDictionary();
+void runAllWords(const string& solverType, const string& selectorType, bool isHardMode) {
+    const vector<string>& words = Helpers::getDictionary();
     size_t successes = 0;
     size_t runs = 0;
-    auto wb = make_shared<WordleBuffer>();
+    WordleSweepStats stats;
+    auto wb = make_shared<WordleBuffer>(&cout);
     wb->write("guess1cands,guess2cands,guess3cands,guess4cands,guess5cands,guess6cands,result,words_left,num_guesses,answer", 0, /*newline=*/ true);
+    wb->finishLine(0);
 
+    auto solver = Helpers::createWordleSolver(solverType, selectorType, isHardMode);
+    auto cache = make_shared<WordleStateCache>(WordleDictionary::getAnswers());
+    auto table = make_shared<WordleTranspositionTable>();
+    solver->setStateCache(cache);
+    solver->setTranspositionTable(table);
+    auto start = chrono::steady_clock::now();
     for (auto& word : words) {
-        if (runOneGame(solverType, word, runs+1, wb)) {
+        if (runReusedGame(solver.get(), /*isWarm=*/runs > 0, word, runs+1, wb, &stats)) {
             successes++;
         }
         g_num_runs++;
         runs++;
     }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
 
-    cout << wb->read() << endl;
+    cout << endl;
     cout << successes << "/" << runs << "=" << std::setprecision(4) << (static_cast<double>(successes)/static_cast<double>(runs)) << endl;
+    stats.print(successes);
+    cache->print();
+    table->print();
+    cout << "games per second: " << std::setprecision(4) << (static_cast<double>(runs)/seconds) << endl;
     cout << "done." << endl;
 }
 
+// Plays one multi-board game, `answerIdxs` holds one answer index per board. Solver must be fresh or reset().
+// Success once every board is solved within the solver's guess limit.
+bool runMultiBoardGame(WordleMultiBoardSolver* solver, const size_t* answerIdxs, size_t idx, shared_ptr<WordleBuffer> wb, WordleSweepStats* stats) {
+    auto& answers = WordleDictionary::getAnswers();
+    size_t numBoards = solver->getNumBoards();
+    WordleChecker checkers[MAX_BOARDS];
+    for (size_t board = 0; board < numBoards; board++) {
+        checkers[board].setAnswer(answers.getWord(answerIdxs[board]));
+    }
+
+    size_t numGuesses = 0;
+    size_t numSolved = 0;
+    while (numSolved < numBoards && numGuesses < solver->getMaxGuesses()) {
+        auto start = chrono::steady_clock::now();
+        string guessStr = solver->makeGuess();
+        if (stats) {
+            stats->numSelections++;
+            stats->selectionNanos += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        }
+        numGuesses++;
+
+        for (size_t board = 0; board < numBoards; board++) {
+            if (solver->isSolved(board)) {
+                continue;
+            }
+            auto guess = WordleGuess(guessStr);
+            size_t unused_numGuesses;
+            if (!checkers[board].check(guess, unused_numGuesses)) {
+                cerr << "Error: [multi] guess [" << guessStr << "] rejected" << endl;
+                throw;
+            }
+            size_t numCandidates = solver->getNumCandidates(board);
+            start = chrono::steady_clock::now();
+            solver->processResult(board, guess);
+            if (stats) {
+                stats->addProcessResult(numCandidates, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+            }
+            numSolved += solver->isSolved(board);
+        }
+    }
+
+    bool isSuccess = numSolved == numBoards;
+    wb->write(isSuccess ? "success," : "failure,", idx);
+    wb->write(to_string(numGuesses) + "," + to_string(numSolved) + ",", idx);
+    for (size_t board = 0; board < numBoards; board++) {
+        wb->write(answers.getWord(answerIdxs[board]), idx);
+        wb->write((board + 1 < numBoards) ? " " : "", idx);
+    }
+    wb->write("", idx, /*newline=*/true);
+    wb->finishLine(idx);
+    if (isSuccess && stats) stats->successGuesses += numGuesses;
+    return isSuccess;
+}
+
+// Plays `numGames` multi-board games, each board's answer drawn at random (distinct within a game).
+// Same `seed`, same games, so sweeps can be compared across commits.
+void runMultiBoardSweep(size_t numBoards, size_t numGames, size_t seed, bool isMultiThreaded) {
+    auto& answers = WordleDictionary::getAnswers();
+    if (numBoards == 0 || numBoards > MAX_BOARDS || numBoards > answers.size()) {
+        cerr << "Error: boards must be 1 to " << MAX_BOARDS << endl;
+        return;
+    }
+
+    auto rng = mt19937_64(seed);
+    auto tuples = vector<size_t>(numGames * numBoards);
+    for (size_t game = 0; game < numGames; game++) {
+        size_t* tuple = &tuples[game * numBoards];
+        for (size_t board = 0; board < numBoards; board++) {
+            do {
+                tuple[board] = rng() % answers.size();
+            } while (find(tuple, tuple + board, tuple[board]) != tuple + board);
+        }
+    }
+
+    WordleSweepStats stats;
+    auto pool = WordleThreadPool(isMultiThreaded ? 0 : 1);
+    auto wb = make_shared<WordleBuffer>(&cout, pool.getNumWorkers() * SWEEP_WINDOW_PER_WORKER,
+                                        SWEEP_LINE_BYTES + numBoards * (LETTER_COUNT + 1));
+    wb->write("result,num_guesses,boards_solved,answers", 0, /*newline=*/ true);
+    wb->finishLine(0);
+
+    // one solver per worker, reset between games like the single-board sweeps
+    auto solvers = vector<unique_ptr<WordleMultiBoardSolver>>(pool.getNumWorkers());
+    auto results = vector<char>(numGames, false);
+    auto start = chrono::steady_clock::now();
+    runGamesInOrder(pool, numGames, [&](size_t workerIdx, size_t game) {
+        auto& solver = solvers[workerIdx];
+        bool isWarm = solver != nullptr;
+        if (!solver) {
+            solver = make_unique<WordleMultiBoardSolver>(numBoards);
+        }
+        size_t allocsBefore = getThreadHeapAllocs();
+        solver->reset();
+        results[game] = runMultiBoardGame(solver.get(), &tuples[game * numBoards], game+1, wb, &stats);
+        if (isWarm) {
+            stats.steadyStateAllocs += getThreadHeapAllocs() - allocsBefore;
+        }
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t successes = count(results.begin(), results.end(), true);
+    cout << endl;
+    cout << successes << "/" << numGames << "=" << std::setprecision(4) << (static_cast<double>(successes)/static_cast<double>(numGames)) << endl;
+    stats.print(successes);
+    cout << "games per second: " << std::setprecision(4) << (static_cast<double>(numGames)/seconds) << endl;
+    cout << "done." << endl;
+}
+
+// Streams answers from `inputFilename` through every core, rows to `outputFilename` in input order ("-": stdin/stdout).
+// Summary goes to stderr, so stdout holds nothing but rows.
+int runBatch(const string& solverType, const string& selectorType, bool isHardMode, const string& inputFilename, const string& outputFilename) {
+    ifstream filein;
+    if (inputFilename != "-") {
+        filein.open(inputFilename);
+        if (!filein) {
+            cerr << "Error: can't read [" << inputFilename << "]" << endl;
+            return 1;
+        }
+    }
+    ofstream fileout;
+    if (outputFilename != "-") {
+        fileout.open(outputFilename);
+        if (!fileout) {
+            cerr << "Error: can't write [" << outputFilename << "]" << endl;
+            return 1;
+        }
+    }
+
+    auto pipeline = WordleBatchPipeline(solverType, selectorType, isHardMode);
+    auto start = chrono::steady_clock::now();
+    size_t numGames = pipeline.run(filein.is_open() ? filein : cin, fileout.is_open() ? static_cast<ostream&>(fileout) : cout);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t successes = pipeline.getNumSuccesses();
+    cerr << successes << "/" << numGames << "=" << std::setprecision(4) << (numGames ? static_cast<double>(successes)/static_cast<double>(numGames) : 0.0) << endl;
+    pipeline.getStats().print(successes, cerr);
+    pipeline.getStateCache().print(cerr);
+    pipeline.getTranspositionTable().print(cerr);
+    cerr << "games per second: " << std::setprecision(4) << (static_cast<double>(numGames)/seconds) << endl;
+    return 0;
+}
+
+// Scores every guess as an opener, then sweeps every answer with each of the best `numSwept`
+//  (by entropy) forced as the trie solver's opener, and writes OPENERS_FILENAME.
+int runOpeners(const string& selectorType, size_t numSwept) {
+    auto selector = WordleSelectorType::FrequencyAndPositionalLetter;
+    if (!selectorType.empty()) {
+        Helpers::getSelectorType(selectorType, selector);
+    }
+    auto start = chrono::steady_clock::now();
+    auto openers = WordleOpeners::score(selector);
+    numSwept = min(numSwept, openers.getNumScores());
+
+    // one solver per worker, the opener swapped between sweeps
+    const vector<string>& words = Helpers::getDictionary();
+    auto pool = WordleThreadPool();
+    auto solvers = vector<unique_ptr<TrieBasedWordleSolver>>(pool.getNumWorkers());
+    auto wb = make_shared<WordleBuffer>();
+    size_t chunkSize = words.size() / (pool.getNumWorkers() * 8) + 1;
+    // picks depend only on the candidates, so every opener's sweep reuses the ones before
+    auto table = make_shared<WordleTranspositionTable>();
+    for (size_t rank = 0; rank < numSwept; rank++) {
+        WordleSweepStats stats;
+        atomic<size_t> successes{0};
+        // states depend on the opener, one cache per sweep
+        auto cache = make_shared<WordleStateCache>(WordleDictionary::getAnswers());
+        pool.run(words.size(), chunkSize, [&](size_t workerIdx, size_t begin, size_t end) {
+            auto& solver = solvers[workerIdx];
+            if (!solver) {
+                solver = make_unique<TrieBasedWordleSolver>(selector);
+            }
+            solver->setOpener(openers.getGuess(rank));
+            solver->setStateCache(cache);
+            solver->setTranspositionTable(table);
+            for (size_t i = begin; i < end; i++) {
+                solver->reset();
+                if (runOneGame(solver.get(), words[i], i+1, wb, &stats)) {
+                    successes++;
+                }
+            }
+        });
+        openers.setSweep(rank, stats.successGuesses, successes, words.size() - successes);
+        if (isLogging(WordleLogLevel::INFO)) {
+            auto& score = openers.getScore(rank);
+            cerr << "swept " << (rank + 1) << "/" << numSwept << " " << openers.getGuess(rank) << ": "
+                 << std::setprecision(6) << score.averageGuesses << " average guesses, " << score.numFailures << " failures" << endl;
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << endl;
+    openers.print(numSwept);
+    size_t best = openers.getBest();
+    if (best != WordleOpeners::NO_OPENER) {
+        cout << "best opener: " << openers.getGuess(best) << endl;
+    }
+    table->print();
+    cout << "seconds: " << std::setprecision(4) << seconds << endl;
+    if (!openers.save(OPENERS_FILENAME)) {
+        return 1;
+    }
+    cout << "Wrote openers: " << OPENERS_FILENAME << endl;
+    return 0;
+}
+
 // Run one iteration of solver against `answer`.
 // Useful for debugging solver & selector.
 void runDebug(unique_ptr<WordleSolverImpl> solver, const string& answer) {
     auto checker = WordleChecker();
     checker.setAnswer(answer);
+    checker.setHardMode(solver->isHardMode());
 
     auto wb = make_shared<WordleBuffer>();
     size_t numGuesses = 0;
     auto guess = WordleGuess(solver->makeInitialGuess(wb, 1));
     bool result = checker.check(guess, numGuesses);
-    if (DEBUG) cout << "> [" << numGuesses << "] " << guess.guessStr << endl;
+    if (isLogging(WordleLogLevel::INFO)) cout << "> [" << numGuesses << "] " << guess.guessStr << endl;
     do {
         if (result) {
             if (guess == CorrectWordleGuess) {
                 break;
             }
             if (numGuesses >= MAX_GUESSES) {
-                if (DEBUG) cerr << "[end]result:failure,words_left:" << dynamic_cast<TrieBasedWordleSolver*>(solver.get())->getNumCandidates() << ",num_guesses:" << numGuesses << ",answer:" << answer << endl;
+                if (isLogging(WordleLogLevel::INFO)) cerr << "[end]result:failure,words_left:" << solver->getNumCandidates() << ",num_guesses:" << numGuesses << ",answer:" << answer << endl;
             }
             solver->processResult(guess);
         }
         guess = WordleGuess(solver->makeSubsequentGuess(numGuesses, wb, 1));
         result = checker.check(guess, numGuesses);
-        if (DEBUG) cout << "> [" << numGuesses << "] " << guess.guessStr << endl;
-        if (result) {
-            if (guess == CorrectWordleGuess) {
-                break;
-            }
-            if (numGuesses >= MAX_GUESSES) {
-                if (DEBUG) cerr << "[end]result:failure,words_left:" << dynamic_cast<TrieBasedWordleSolver*>(solver.get())->getNumCandidates() << ",num_guesses:" << numGuesses << ",answer:" << answer << endl;
-            }
-            solver->processResult(guess);
+        if (isLogging(WordleLogLevel::INFO)) cout << "> [" << numGuesses << "] " << guess.guessStr << endl;
+        // processed at the top of the next pass, solvers expect each result once
+        if (result && guess == CorrectWordleGuess) {
+            break;
         }
     } while (numGuesses < MAX_GUESSES);
 
     if (numGuesses >= MAX_GUESSES && guess != CorrectWordleGuess) {
-        if (DEBUG || DEBUG_UNICODE) cerr << "result:failure,words_left:" << dynamic_cast<TrieBasedWordleSolver*>(solver.get())->getNumCandidates() << ",num_guesses:" << numGuesses << ",answer:" << answer << endl;
+        if (isLogging(WordleLogLevel::INFO)) cerr << "result:failure,words_left:" << solver->getNumCandidates() << ",num_guesses:" << numGuesses << ",answer:" << answer << endl;
     } else {
         cout << "\nWordle " << numGuesses << "/" << MAX_GUESSES << endl;
-        if (DEBUG) cerr << "result:success,words_left:" << dynamic_cast<TrieBasedWordleSolver*>(solver.get())->getNumCandidates() << ",num_guesses:" << numGuesses << endl;
+        if (isLogging(WordleLogLevel::INFO)) cerr << "result:success,words_left:" << solver->getNumCandidates() << ",num_guesses:" << numGuesses << endl;
     }
 }
 
@@ -166,10 +493,10 @@ int interactiveMode(unique_ptr<WordleSolverImpl> solver) {
 // Augments IRL game play #sorrynotsorry
 int cheatMode(unique_ptr<WordleSolverImpl> solver) {
     // Decls:
-    // wordle_trie.cpp:14 WordleTrie::printCandidates(), no scores
+    // wordle_candidate_filter.cpp:14 WordleCandidateFilter::printCandidates(), no scores
     // wordle_selectors.cpp:114 MostCommonLetterSelector<>::printCandidates(), scores
     // Callers:
-    // wordlist_wordle_solver.cpp:116 TrieBasedWordleSolver::processResult() -> trie, no scores
+    // wordlist_wordle_solver.cpp:116 TrieBasedWordleSolver::processResult() -> candidate filter, no scores
     // wordle_selectors.cpp:75 MostCommonLetterSelector<>::select() -> mcl, scores
 
     size_t numGuesses = 1;
@@ -196,3 +523,5 @@ int cheatMode(unique_ptr<WordleSolverImpl> solver) {
 
     return 0;
 }
+
+} // namespace WORDLE_NAMESPACE
@@ -1,16 +1,44 @@
+#pragma once
+
 #include "wordle_buffer.h"
+#include "wordle_multi_board.h"
 #include "wordle_rules.h"
 #include "wordle_solver.h"
 
+#include <atomic>
+#include <iostream>
 #include <memory>
 #include <string>
 
 //using namespace std;
 
-bool runOneGame(const std::string& solverType, const std::string& answer, size_t idx, std::shared_ptr<WordleBuffer> wb);
-void runAllWordsMultiThreaded(const std::string& solverType);
-void runAllWords(const std::string& solverType);
+namespace WORDLE_NAMESPACE {
+
+// Aggregated over every game of a sweep, safe to share between threads
+struct WordleSweepStats {
+    std::atomic<size_t> successGuesses{0};
+    std::atomic<size_t> numSelections{0};
+    std::atomic<size_t> selectionNanos{0};
+    std::atomic<size_t> steadyStateAllocs{0}; // heap allocations in games after each solver's first
+    // processResult cost by candidates before the call, bucket b holds [2^(b-1), 2^b)
+    static const size_t NUM_CANDIDATE_BUCKETS = 16;
+    std::atomic<size_t> processCalls[NUM_CANDIDATE_BUCKETS]{};
+    std::atomic<size_t> processNanos[NUM_CANDIDATE_BUCKETS]{};
+    void addProcessResult(size_t numCandidates, size_t nanos);
+    void print(size_t successes, std::ostream& os=std::cout) const;
+};
+
+bool runOneGame(const std::string& solverType, const std::string& selectorType, const std::string& answer, size_t idx, std::shared_ptr<WordleBuffer> wb, WordleSweepStats* stats, bool isHardMode=false);
+bool runOneGame(WordleSolverImpl* solver, const std::string& answer, size_t idx, std::shared_ptr<WordleBuffer> wb, WordleSweepStats* stats);
+bool runReusedGame(WordleSolverImpl* solver, bool isWarm, const std::string& answer, size_t idx, std::shared_ptr<WordleBuffer> wb, WordleSweepStats* stats);
+void runAllWordsMultiThreaded(const std::string& solverType, const std::string& selectorType, bool isHardMode=false);
+void runAllWords(const std::string& solverType, const std::string& selectorType, bool isHardMode=false);
+bool runMultiBoardGame(WordleMultiBoardSolver* solver, const size_t* answerIdxs, size_t idx, std::shared_ptr<WordleBuffer> wb, WordleSweepStats* stats);
+void runMultiBoardSweep(size_t numBoards, size_t numGames, size_t seed, bool isMultiThreaded);
+int runOpeners(const std::string& selectorType, size_t numSwept);
+int runBatch(const std::string& solverType, const std::string& selectorType, bool isHardMode, const std::string& inputFilename, const std::string& outputFilename);
 void runDebug(std::unique_ptr<WordleSolverImpl> solver, const std::string& answer);
 int interactiveMode(std::unique_ptr<WordleSolverImpl> solver);
 int cheatMode(std::unique_ptr<WordleSolverImpl> solver);
 
+} // namespace WORDLE_NAMESPACE
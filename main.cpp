@@ -6,129 +6,52 @@
 
 /*
 Where To Edit Strategies:
-Solver:   in main()
-Selector: in the respective `WordleSolver` constructor. Currently all locations in `wordlist_wordle_solver.cpp`.
+Solver:   in runMain(), `wordle_main.cpp`
+Selector: --selector on the cmd line, defaults to FrequencyAndPositionalLetter in `wordlist_wordle_solver.h`.
  */
 
-#include "game_modes.h"
-#include "wordle_buffer.h"
-#include "wordle_checker.h"
-#include "wordle_helpers.h"
 #include "wordle_rules.h"
-#include "wordle_selector.h"
-#include "wordle_solver.h"
-#include "wordlist_wordle_solver.h"
 
-#include <iomanip>
+#include <fstream>
 #include <iostream>
-#include <stdlib.h>
 #include <string>
 
-#include <boost/program_options.hpp>
-#include <boost/program_options/variables_map.hpp>
-
 using namespace std;
 
-namespace po = boost::program_options;
 
+// runMain() of each word length, from wordle_main.cpp built into wordle_core_N
+namespace wordle4 { int runMain(int argc, char* argv[]); }
+namespace wordle5 { int runMain(int argc, char* argv[]); }
+namespace wordle6 { int runMain(int argc, char* argv[]); }
+namespace wordle7 { int runMain(int argc, char* argv[]); }
+namespace wordle8 { int runMain(int argc, char* argv[]); }
 
-void printUsage() {
-    cerr << "Usage: solver [-h/--help] --mode mode [-t/--multi] --word word" << endl << endl;
-    cerr << "Options:" << endl;
-    cerr << " -h,--help   : produce help message" << endl;
-    cerr << " -s,--solver : choose between: trie(default),wordlist" << endl;
-    cerr << " -m,--mode   : choose between: all,cheat,debug,interactive,one" << endl;
-    cerr << " -t,--multi  : multi-threaded (assumes --mode all)" << endl;
-    cerr << " -w,--word   : answer word for certain modes" << endl;
-    exit(1);
+// letters in the first word of the answers list, WORD_LENGTH if there's none to read
+static size_t readWordLength() {
+    auto filein = ifstream(DICTIONARY_FILENAME);
+    string word;
+    if (!(filein >> word)) {
+        return WORD_LENGTH;
+    }
+    return word.size();
 }
 
 int main(int argc, char* argv[]) {
-    po::options_description desc("Allowed options");
-    desc.add_options()
-        ("help,h", "produce help message")
-        ("solver,s", po::value<string>(), "choose between: trie(default),wordlist")
-        // ("selector,l", po::value<string>(), "EnhancedRandom,FrequencyAndPositionalLetter(default),ImprovedMostCommonLetter,NaiveMostCommonLetter,PositionalLetter,Random")
-        ("mode,m", po::value<string>(), "choose between: all,cheat,debug,interactive,one")
-        ("multi,t", "multi-threaded (assumes --mode all)")
-        ("word,w", po::value<string>(), "answer word for certain modes")
-        ;
-
-    po::variables_map vm;
-    try {
-        po::store(po::parse_command_line(/*argc=*/argc, /*argv=*/argv, /*options_desc=*/desc), vm);
-    } catch (const std::exception& e) {
-        cout << "Exception Error: " << e.what() << endl;
-        return 3;
-    }
-
-    po::notify(vm);
-    if (vm.count("help")) {
-        printUsage();
+    // one binary for every length, the word lists decide which engine runs
+    size_t wordLength = readWordLength();
+    switch (wordLength) {
+    case 4:
+        return wordle4::runMain(argc, argv);
+    case 5:
+        return wordle5::runMain(argc, argv);
+    case 6:
+        return wordle6::runMain(argc, argv);
+    case 7:
+        return wordle7::runMain(argc, argv);
+    case 8:
+        return wordle8::runMain(argc, argv);
+    default:
+        cerr << "Error: [main] " << DICTIONARY_FILENAME << " starts with a " << wordLength << "-letter word, the solver plays 4 to 8 letters" << endl;
+        return 1;
     }
-
-    // TODO: Not supported yet, because this is baked into the solvers.
-    //       Need to provide mechanism to pass this through.
-    // auto selector =
-    // if (vm.count("selector")) {
-    // }
-
-    if (vm.count("mode")) {
-        cout << "Wordle Solver v" << VERSION << endl;
-        string solverType = "trie";
-        if (vm.count("solver")) {
-            solverType = vm["solver"].as<string>();
-        }
-        auto solver = Helpers::createWordleSolver(solverType);
-        auto solverMode = vm["mode"].as<string>();
-        cout << "mode:" << solverMode << endl;
-
-        if (solverMode == "all") {
-            if (vm.count("multi")) {
-                cout << "multi-threaded" << endl << endl;
-                runAllWordsMultiThreaded(solverType);
-            } else {
-                cout << endl;
-                runAllWords(solverType);
-            }
-        } else if (solverMode == "one") {
-            if (!vm.count("word")) {
-                cerr << "'one' mode requires a 'word' as a solution" << endl;
-                printUsage();
-            }
-            if (!Helpers::isWordInDictionary(vm["word"].as<string>())) {
-                cerr << "Error: [" << vm["word"].as<string>() << "] not in the wordlist" << endl;
-                return 1;
-            }
-            cout << endl;
-            cout << "TODO: pass unicode in as an option" << endl;
-            auto wb = make_shared<WordleBuffer>();
-            wb->write("guess1cands,guess2cands,guess3cands,guess4cands,guess5cands,guess6cands,result,words_left,num_guesses,answer", 0, /*newline=*/ true);
-            runOneGame(solverType, vm["word"].as<string>(), 1, wb);
-        } else if (solverMode == "cheat") {
-            cout << endl;
-            cheatMode(move(solver));
-        } else if (solverMode == "debug") {
-            if (!vm.count("word")) {
-                cerr << "'debug' mode requires a 'word' as a solution" << endl;
-                printUsage();
-            }
-            if (!Helpers::isWordInDictionary(vm["word"].as<string>())) {
-                cerr << "Error: [" << vm["word"].as<string>() << "] not in the wordlist" << endl;
-                return 1;
-            }
-            cout << endl;
-            runDebug(move(solver), vm["word"].as<string>());
-        } else if (solverMode == "interactive") {
-            cout << endl;
-            interactiveMode(move(solver));
-        } else {
-            cerr << "mode [" << solverMode << "] not recognized" << endl;
-            printUsage();
-        }
-    } else {
-        printUsage();
-    }
-
-    return 0;
 }
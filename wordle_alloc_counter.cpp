@@ -0,0 +1,38 @@
+#include "wordle_alloc_counter.h"
+#include "wordle_rules.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+
+static thread_local size_t t_numHeapAllocs = 0;
+
+#if COUNT_HEAP_ALLOCS == true
+// Replaces the global allocator so steady-state allocation counts can be checked.
+// Array, nothrow and sized-delete forms all forward here in the standard library.
+void* operator new(size_t size) {
+    t_numHeapAllocs++;
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t unused_size) noexcept {
+    free(p);
+}
+#endif
+
+size_t getThreadHeapAllocs() {
+    return t_numHeapAllocs;
+}
+
+bool isCountingHeapAllocs() {
+    return COUNT_HEAP_ALLOCS;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "wordle_rules.h"
+
+#include <cstddef>
+
+using namespace std;
+
+
+/**
+ * With COUNT_HEAP_ALLOCS, global operator new is replaced by a per-thread counting wrapper
+ *  around malloc, behind the steady-state allocation checks: a warm solver reused for the
+ *  next game should not allocate at all.
+ */
+
+// Calls to global operator new made by the calling thread, 0 unless COUNT_HEAP_ALLOCS
+size_t getThreadHeapAllocs();
+// COUNT_HEAP_ALLOCS of the counter linked in, the engine itself is built once for every binary
+bool isCountingHeapAllocs();
@@ -0,0 +1,108 @@
+#include "wordle_batch.h"
+#include "game_modes.h"
+#include "wordle_buffer.h"
+#include "wordle_helpers.h"
+#include "wordle_rules.h"
+#include "wordle_state_cache.h"
+#include "wordle_thread_pool.h"
+#include "wordle_transposition_table.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+WordleBatchPipeline::WordleBatchPipeline(const string& solverType, const string& selectorType, bool isHardMode,
+                                         size_t numWorkers, size_t window)
+    : m_solverType(solverType), m_selectorType(selectorType), m_isHardMode(isHardMode),
+      m_numWorkers(numWorkers ? numWorkers : max<size_t>(1, thread::hardware_concurrency())), m_answers(max<size_t>(1, window)),
+      m_cache(make_shared<WordleStateCache>(WordleDictionary::getAnswers())), m_table(make_shared<WordleTranspositionTable>()) {
+    for (auto& answer : m_answers) {
+        answer.reserve(SWEEP_LINE_BYTES);
+    }
+}
+
+size_t WordleBatchPipeline::run(istream& in, ostream& out) {
+    // row 0 is the header, game i is row i+1
+    m_wb = make_shared<WordleBuffer>(&out, m_answers.size());
+    m_wb->write("guess1cands,guess2cands,guess3cands,guess4cands,guess5cands,guess6cands,result,words_left,num_guesses,answer", 0, /*newline=*/ true);
+    m_wb->finishLine(0);
+
+    auto workers = vector<thread>();
+    for (size_t i = 0; i < m_numWorkers; i++) {
+        workers.push_back(thread(&WordleBatchPipeline::workerLoop, this));
+    }
+
+    string line;
+    while (getline(in, line)) {
+        // tolerate CRLF and padding, skip blank lines; spaces inside a word leave it invalid
+        auto isSpace = [](char c) { return isspace(static_cast<unsigned char>(c)) != 0; };
+        line.erase(find_if_not(line.rbegin(), line.rend(), isSpace).base(), line.end());
+        line.erase(line.begin(), find_if_not(line.begin(), line.end(), isSpace));
+        if (line.empty()) {
+            continue;
+        }
+        // the answer `window` games back shares the slot, its row must be out first
+        m_wb->waitForSlot(m_numRead + 1);
+        {
+            lock_guard<mutex> lck(m_mtx);
+            m_answers[m_numRead % m_answers.size()].assign(line);
+            m_numRead++;
+        }
+        m_workCv.notify_one();
+    }
+
+    {
+        lock_guard<mutex> lck(m_mtx);
+        m_isInputDone = true;
+    }
+    m_workCv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    out.flush();
+    return m_numRead;
+}
+
+void WordleBatchPipeline::workerLoop() {
+    // one worker per core already, a selector splitting its search across threads would oversubscribe them
+    WordleThreadPool::setWorkerThread();
+    auto solver = Helpers::createWordleSolver(m_solverType, m_selectorType, m_isHardMode);
+    solver->setStateCache(m_cache);
+    solver->setTranspositionTable(m_table);
+    bool isWarm = false;
+    while (true) {
+        size_t idx;
+        {
+            unique_lock<mutex> lck(m_mtx);
+            m_workCv.wait(lck, [this]() { return m_numTaken < m_numRead || m_isInputDone; });
+            if (m_numTaken == m_numRead) {
+                return;
+            }
+            idx = m_numTaken++;
+        }
+
+        // the answer stays put until this game's row is written
+        const string& answer = m_answers[idx % m_answers.size()];
+        bool isValid = answer.size() == LETTER_COUNT &&
+                       all_of(answer.begin(), answer.end(), [](char c) { return c >= 'a' && c <= 'z'; }) &&
+                       Helpers::isWordInDictionary(answer);
+        if (isValid) {
+            if (runReusedGame(solver.get(), isWarm, answer, idx + 1, m_wb, &m_stats)) {
+                m_numSuccesses++;
+            }
+            isWarm = true;
+        } else {
+            m_wb->write(",,,,,,invalid,,,", idx + 1);
+            m_wb->write(answer, idx + 1, /*newline=*/true);
+            m_wb->finishLine(idx + 1);
+        }
+    }
+}
+
+} // namespace WORDLE_NAMESPACE
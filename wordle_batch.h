@@ -0,0 +1,68 @@
+#pragma once
+
+#include "game_modes.h"
+#include "wordle_buffer.h"
+#include "wordle_rules.h"
+#include "wordle_state_cache.h"
+#include "wordle_transposition_table.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+ * Streaming solve: answers in, one CSV row per game out, in input order, as games finish.
+ *
+ *   reader (caller) --> window --> worker x N --> WordleBuffer --> out
+ *
+ * Reading, solving and writing overlap. Answers wait in a ring the size of the output window, and an
+ *  answer's slot is reused once its row is written, so the reader waits once it's `window` games ahead
+ *  of the output, and memory stays bounded however long the input is.
+ * Workers take games in input order and write their rows straight into the buffer.
+ * One solver per worker, reset between games like the sweeps, sharing one `WordleStateCache` and `WordleTranspositionTable`.
+ */
+class WordleBatchPipeline {
+public:
+    WordleBatchPipeline(const string& solverType, const string& selectorType, bool isHardMode,
+                        size_t numWorkers=0, size_t window=OUTPUT_WINDOW);
+
+    // Solves every answer in `in` (one per line, blank lines skipped), rows to `out`.
+    // Returns the number of games played.
+    size_t run(istream& in, ostream& out);
+    const WordleSweepStats& getStats() const { return m_stats; }
+    size_t getNumSuccesses() const { return m_numSuccesses; }
+    const WordleStateCache& getStateCache() const { return *m_cache; }
+    const WordleTranspositionTable& getTranspositionTable() const { return *m_table; }
+private:
+    void workerLoop();
+
+    string m_solverType;
+    string m_selectorType;
+    bool m_isHardMode;
+    size_t m_numWorkers;
+    vector<string> m_answers; // ring, game i in m_answers[i % window]
+    shared_ptr<WordleBuffer> m_wb;
+    shared_ptr<WordleStateCache> m_cache;
+    shared_ptr<WordleTranspositionTable> m_table;
+
+    mutex m_mtx;
+    condition_variable m_workCv; // an answer came in, or the input ended
+    size_t m_numRead{0};
+    size_t m_numTaken{0};
+    bool m_isInputDone{false};
+
+    WordleSweepStats m_stats;
+    atomic<size_t> m_numSuccesses{0};
+};
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,322 @@
+/**
+ * Microbenchmarks for the solver's hot paths, in the style of Google Benchmark:
+ *  each benchmark's batch size grows until a batch runs for at least --min-time,
+ *  then ns/op, heap allocations/op and (for whole games) games/second are reported.
+ *
+ * $ ./bench                             # everything, table to stdout, JSON to bench.json
+ * $ ./bench --filter selector --out x.json
+ *
+ * The trie's insert and fixupGreen/fixupYellow/fixupBlack benchmarks went with the trie, its
+ *  stand-ins are dictionary/getWordId and filter/applyConstraint: JSON from before then
+ *  times different code under the old trie/ names.
+ */
+
+#include "game_modes.h"
+#include "wordle_alloc_counter.h"
+#include "wordle_buffer.h"
+#include "wordle_candidate_filter.h"
+#include "wordle_candidates.h"
+#include "wordle_checker.h"
+#include "wordle_constraint.h"
+#include "wordle_dictionary.h"
+#include "wordle_feedback.h"
+#include "wordle_helpers.h"
+#include "wordle_multi_board.h"
+#include "wordle_rules.h"
+#include "wordle_selector.h"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+using namespace std;
+// the 5-letter engine, wordle_core_5
+using namespace WORDLE_NAMESPACE;
+
+namespace po = boost::program_options;
+
+
+static const size_t BENCH_MAX_ITERATIONS = 1000000000;
+
+struct WordleBenchmark {
+    string name;
+    function<void(size_t)> setup; // untimed, before each batch of `iterations`
+    function<void(size_t)> run;   // timed, runs `iterations` ops
+    size_t itemsPerOp{1};         // items an op covers, so ns/op is per item
+    size_t gamesPerOp{0};         // 0 unless an op plays whole games
+};
+
+struct WordleBenchResult {
+    string name;
+    size_t iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double gamesPerSecond;
+};
+
+// swallows the selectors' and checker's console output while timing, errors included
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char* unused_s, streamsize n) override { return n; }
+};
+
+static WordleBenchResult runBenchmark(const WordleBenchmark& bench, double minSeconds) {
+    // warm up: first use loads dictionaries, sizes scratch buffers, etc.
+    bench.setup(1);
+    bench.run(1);
+
+    size_t iterations = 1;
+    while (true) {
+        bench.setup(iterations);
+        size_t allocsBefore = getThreadHeapAllocs();
+        auto start = chrono::steady_clock::now();
+        bench.run(iterations);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        size_t allocs = getThreadHeapAllocs() - allocsBefore;
+
+        if (seconds >= minSeconds || iterations >= BENCH_MAX_ITERATIONS) {
+            double ops = static_cast<double>(iterations * bench.itemsPerOp);
+            return WordleBenchResult{
+                bench.name,
+                iterations,
+                seconds * 1e9 / ops,
+                static_cast<double>(allocs) / ops,
+                static_cast<double>(iterations * bench.gamesPerOp) / seconds,
+            };
+        }
+
+        // same growth rule as Google Benchmark: aim 40% past the target, at most 10x per step
+        double multiplier = (seconds > 0) ? min(10.0, max(1.4, minSeconds * 1.4 / seconds)) : 10.0;
+        iterations = min(BENCH_MAX_ITERATIONS, static_cast<size_t>(static_cast<double>(iterations) * multiplier) + 1);
+    }
+}
+
+static vector<WordleBenchmark> makeBenchmarks() {
+    auto benchmarks = vector<WordleBenchmark>();
+    const auto& answers = WordleDictionary::getAnswers();
+    const auto& guesses = WordleDictionary::getGuesses();
+    auto noSetup = [](size_t unused_iterations) {};
+    // what a benchmark times is built by its setup on first use, so --filter only pays for what it runs
+
+    // checker
+    auto checker = make_shared<unique_ptr<WordleChecker>>();
+    benchmarks.push_back({"checker/check", [checker, &answers](size_t unused_iterations) {
+        if (!*checker) {
+            *checker = make_unique<WordleChecker>();
+            (*checker)->setAnswer((LETTER_COUNT == 5) ? "cloth" : answers.getWord(answers.size() / 2));
+        }
+    }, [checker, &answers](size_t iterations) {
+        size_t numGuesses = 0;
+        for (size_t i = 0; i < iterations; i++) {
+            auto guess = WordleGuess(answers.getWord(i % answers.size()));
+            (*checker)->check(guess, numGuesses);
+        }
+    }});
+
+    // dictionary and candidate filter
+    benchmarks.push_back({"dictionary/getWordId", noSetup, [&guesses](size_t iterations) {
+        size_t wordId;
+        for (size_t i = 0; i < iterations; i++) {
+            guesses.getWordId(guesses.getWord(i % guesses.size()), wordId);
+        }
+    }});
+    // one guess's feedback against each answer in turn, applied to every guess as candidates
+    auto filter = make_shared<unique_ptr<WordleCandidateFilter>>();
+    auto constraints = make_shared<vector<WordleConstraint>>();
+    benchmarks.push_back({"filter/applyConstraint", [filter, constraints, &answers, &guesses](size_t unused_iterations) {
+        if (!*filter) {
+            *filter = make_unique<WordleCandidateFilter>(guesses);
+            const string& guess = answers.getWord(0);
+            for (size_t answerIdx = 0; answerIdx < answers.size(); answerIdx++) {
+                constraints->push_back(WordleConstraint(WordleGuess(guess, decodeFeedback(computeFeedback(guess, answers.getWord(answerIdx))))));
+            }
+        }
+    }, [filter, constraints](size_t iterations) {
+        for (size_t i = 0; i < iterations; i++) {
+            (*filter)->reset();
+            (*filter)->applyConstraint((*constraints)[i % constraints->size()]);
+        }
+    }});
+
+    // selectors, each op is the first select of a game: over every answer, and over the
+    //  answers left without an 'e' or an 's' (what a typical opener leaves behind)
+    // EnhancedRandom is left out, it spins on srand(time) until the clock ticks over
+    for (auto& selectorName : {"Random", "NaiveMostCommonLetter", "ImprovedMostCommonLetter",
+                               "PositionalLetter", "FrequencyAndPositionalLetter", "Entropy", "Minimax"}) {
+        WordleSelectorType selectorType;
+        Helpers::getSelectorType(selectorName, selectorType);
+        // one selector per name, shared by both candidate sets
+        auto selector = make_shared<unique_ptr<WordleSelector<CandidateIterator>>>();
+        for (auto setName : {"all", "narrowed"}) {
+            auto candidates = make_shared<unique_ptr<WordleCandidateSet>>();
+            bool isNarrowed = (string(setName) == "narrowed");
+            benchmarks.push_back({string("selector/") + selectorName + "/" + setName,
+                                  [selector, candidates, selectorType, isNarrowed, &answers](size_t unused_iterations) {
+                if (!*selector) {
+                    selector->reset(WordleSelectorFactory<CandidateIterator>::makeWordleSelector(selectorType));
+                }
+                if (!*candidates) {
+                    *candidates = make_unique<WordleCandidateSet>(&answers.getWords());
+                    if (isNarrowed) {
+                        (*candidates)->remove(answers.getLetterMask('e'));
+                        (*candidates)->remove(answers.getLetterMask('s'));
+                    }
+                }
+            }, [selector, candidates](size_t iterations) {
+                auto knowns = vector<WordleKnown>(LETTER_COUNT, {char(), WordleResult::BLACK});
+                auto& candidateSet = **candidates;
+                for (size_t i = 0; i < iterations; i++) {
+                    (*selector)->reset();
+                    (*selector)->select(candidateSet.begin(), candidateSet.end(), candidateSet.size(), knowns, 0);
+                }
+            }});
+        }
+    }
+
+    // whole games, one reused solver per benchmark, made on first use (the tree may need building)
+    for (auto& [solverType, selectorType] : {make_pair("trie", "FrequencyAndPositionalLetter"),
+                                             make_pair("trie", "Entropy"),
+                                             make_pair("tree", "")}) {
+        auto solver = make_shared<unique_ptr<WordleSolverImpl>>();
+        auto wb = make_shared<shared_ptr<WordleBuffer>>();
+        string name = string("game/runOneGame/") + solverType + (string(selectorType).empty() ? "" : string("/") + selectorType);
+        benchmarks.push_back({name, [solver, wb, solverType, selectorType](size_t iterations) {
+            if (!*solver) {
+                *solver = Helpers::createWordleSolver(solverType, selectorType);
+            }
+            *wb = make_shared<WordleBuffer>();
+        }, [solver, wb, &answers](size_t iterations) {
+            for (size_t i = 0; i < iterations; i++) {
+                runReusedGame(solver->get(), /*isWarm=*/true, answers.getWord(i % answers.size()), i+1, *wb, nullptr);
+            }
+        }, /*itemsPerOp=*/1, /*gamesPerOp=*/1});
+    }
+
+    // multi-board games over a fixed spread of answer tuples, distinct answers per game
+    for (size_t numBoards : {4, 8}) {
+        auto solver = make_shared<unique_ptr<WordleMultiBoardSolver>>();
+        auto wb = make_shared<shared_ptr<WordleBuffer>>();
+        benchmarks.push_back({"game/runMultiBoardGame/" + to_string(numBoards), [solver, wb, numBoards](size_t iterations) {
+            if (!*solver) {
+                *solver = make_unique<WordleMultiBoardSolver>(numBoards);
+            }
+            *wb = make_shared<WordleBuffer>(nullptr, OUTPUT_WINDOW, 64 + numBoards * (LETTER_COUNT + 1));
+        }, [solver, wb, numBoards, &answers](size_t iterations) {
+            size_t answerIdxs[MAX_BOARDS];
+            for (size_t i = 0; i < iterations; i++) {
+                for (size_t board = 0; board < numBoards; board++) {
+                    answerIdxs[board] = (i * 7919 + board * (answers.size() / numBoards)) % answers.size();
+                }
+                (*solver)->reset();
+                runMultiBoardGame(solver->get(), answerIdxs, i+1, *wb, nullptr);
+            }
+        }, /*itemsPerOp=*/1, /*gamesPerOp=*/1});
+    }
+
+    benchmarks.push_back({"game/runAllWords/trie/FrequencyAndPositionalLetter", noSetup, [](size_t iterations) {
+        for (size_t i = 0; i < iterations; i++) {
+            runAllWords("trie", "FrequencyAndPositionalLetter");
+        }
+    }, /*itemsPerOp=*/1, /*gamesPerOp=*/answers.size()});
+
+    return benchmarks;
+}
+
+static bool writeJson(const string& filename, const vector<WordleBenchResult>& results) {
+    auto fileout = ofstream(filename);
+    if (!fileout) {
+        cerr << "Error: [bench] can't write " << filename << endl;
+        return false;
+    }
+
+    auto now = chrono::system_clock::to_time_t(chrono::system_clock::now());
+    fileout << "{" << endl;
+    fileout << "  \"context\": {" << endl;
+    fileout << "    \"date\": \"" << put_time(localtime(&now), "%Y-%m-%dT%H:%M:%S") << "\"," << endl;
+    fileout << "    \"version\": \"" << fixed << setprecision(1) << VERSION << defaultfloat << "\"," << endl;
+    fileout << "    \"num_cpus\": " << thread::hardware_concurrency() << "," << endl;
+    fileout << "    \"count_heap_allocs\": " << (isCountingHeapAllocs() ? "true" : "false") << endl;
+    fileout << "  }," << endl;
+    fileout << "  \"benchmarks\": [" << endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        auto& result = results[i];
+        fileout << "    {" << endl;
+        fileout << "      \"name\": \"" << result.name << "\"," << endl;
+        fileout << "      \"iterations\": " << result.iterations << "," << endl;
+        fileout << "      \"real_time\": " << setprecision(6) << result.nsPerOp << "," << endl;
+        fileout << "      \"time_unit\": \"ns\"," << endl;
+        fileout << "      \"allocs_per_op\": " << setprecision(6) << result.allocsPerOp;
+        if (result.gamesPerSecond > 0) {
+            fileout << "," << endl << "      \"games_per_second\": " << setprecision(6) << result.gamesPerSecond;
+        }
+        fileout << endl << "    }" << ((i+1 < results.size()) ? "," : "") << endl;
+    }
+    fileout << "  ]" << endl;
+    fileout << "}" << endl;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("filter,f", po::value<string>(), "only run benchmarks whose name contains this")
+        ("out,o", po::value<string>()->default_value("bench.json"), "JSON results file")
+        ("min-time", po::value<double>()->default_value(0.5), "seconds each benchmark's final batch must run")
+        ;
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(/*argc=*/argc, /*argv=*/argv, /*options_desc=*/desc), vm);
+    } catch (const std::exception& e) {
+        cout << "Exception Error: " << e.what() << endl;
+        return 3;
+    }
+    po::notify(vm);
+    if (vm.count("help")) {
+        cerr << desc << endl;
+        return 1;
+    }
+    string filter = vm.count("filter") ? vm["filter"].as<string>() : "";
+
+    // time the solver, not its logging; anything left still goes nowhere
+    g_log_level = WordleLogLevel::QUIET;
+    auto nullBuffer = NullBuffer();
+    auto coutBuffer = cout.rdbuf(&nullBuffer);
+    auto cerrBuffer = cerr.rdbuf(&nullBuffer);
+    auto benchmarks = makeBenchmarks();
+    cout.rdbuf(coutBuffer);
+    cerr.rdbuf(cerrBuffer);
+
+    cout << left << setw(60) << "Benchmark" << right << setw(14) << "ns/op" << setw(14) << "allocs/op"
+         << setw(14) << "games/s" << setw(12) << "iterations" << endl;
+    auto results = vector<WordleBenchResult>();
+    for (auto& bench : benchmarks) {
+        if (bench.name.find(filter) == string::npos) {
+            continue;
+        }
+        cout.rdbuf(&nullBuffer);
+        cerr.rdbuf(&nullBuffer);
+        results.push_back(runBenchmark(bench, vm["min-time"].as<double>()));
+        cout.rdbuf(coutBuffer);
+        cerr.rdbuf(cerrBuffer);
+
+        auto& result = results.back();
+        cout << left << setw(60) << result.name << right << fixed << setprecision(1)
+             << setw(14) << result.nsPerOp << setprecision(3) << setw(14) << result.allocsPerOp << setprecision(1)
+             << setw(14) << result.gamesPerSecond << setw(12) << result.iterations << defaultfloat << endl;
+    }
+
+    return writeJson(vm["out"].as<string>(), results) ? 0 : 1;
+}
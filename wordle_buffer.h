@@ -1,40 +1,102 @@
 #pragma once
 
+#include "wordle_rules.h"
+
+#include <atomic>
+#include <cstdint>
 #include <iostream>
-#include <mutex>
-#include <sstream>
+#include <memory>
 #include <string>
-#include <map>
+#include <string_view>
+
+namespace WORDLE_NAMESPACE {
+
+// room for one CSV line of sweep output
+static const size_t SWEEP_LINE_BYTES = 64;
 
+/**
+ * Ordered output sink: rows are written by many threads, each row by one thread, and go out in index order.
+ *
+ *   slot = idx % window   [ row idx-window ... written ][ row idx: owner appends ][ finished, waiting ] ...
+ *
+ * A row's owner appends to its slot without locking. finishLine() hands it over, and whichever thread
+ *  finishes the row at the head of the window writes out every finished row behind it.
+ * A slot is reused once its row is written, so an owner runs at most `window` rows ahead of the output
+ *  and waits otherwise. Rows must be started roughly in index order, or the window must cover them all.
+ * Without `out` nothing is kept: finished rows are dropped and nothing ever waits.
+ */
 class WordleBuffer {
 public:
-    void write(const std::string& str, size_t idx, bool newline=false) {
-        std::lock_guard<std::mutex> lck(m_mtx);
-        //*m_buf << str;
-        //m_str += str;
-        if (m_map.find(idx) == m_map.end()) {
-            if (newline) {
-                m_map[idx] = str + "\n";
-            } else {
-                m_map[idx] = str;
-            }
-        } else {
-            if (newline) {
-                m_map[idx] += str + "\n";
-            } else {
-                m_map[idx] += str;
-            }
+    WordleBuffer(std::ostream* out=nullptr, size_t window=OUTPUT_WINDOW, size_t lineBytes=SWEEP_LINE_BYTES)
+        : m_out(out), m_window(window ? window : 1), m_slots(new Slot[m_window]) {
+        for (size_t i = 0; i < m_window; i++) {
+            m_slots[i].line.reserve(lineBytes);
+        }
+    }
+
+    void write(std::string_view str, size_t idx, bool newline=false) {
+        waitForSlot(idx);
+        auto& line = m_slots[idx % m_window].line;
+        line += str;
+        if (newline) {
+            line += '\n';
+        }
+    }
+
+    // Row `idx` is complete, it goes out once every row before it has
+    void finishLine(size_t idx) {
+        auto& slot = m_slots[idx % m_window];
+        if (!m_out) {
+            slot.line.clear();
+            return;
         }
+        slot.finishedIdx.store(idx);
+        drain();
     }
 
-    std::string read() {
-        std::string s;
-        for (auto& i : m_map) {
-            s += i.second;
+    // Blocks until row `idx` has a slot, i.e. row idx-window has been written
+    void waitForSlot(size_t idx) {
+        if (!m_out) {
+            return;
+        }
+        size_t numWritten;
+        while (idx >= (numWritten = m_numWritten.load(std::memory_order_acquire)) + m_window) {
+            m_numWritten.wait(numWritten, std::memory_order_acquire);
         }
-        return s;
     }
+
+    size_t getNumWritten() const { return m_numWritten.load(std::memory_order_acquire); }
 private:
-    std::map<size_t, std::string> m_map;
-    std::mutex m_mtx{};
+    struct Slot {
+        std::string line;
+        std::atomic<size_t> finishedIdx{SIZE_MAX};
+    };
+
+    void drain() {
+        // one drainer at a time; a row finished while another thread holds the drain is either seen by it,
+        //  or its finisher sees the drain released on the re-check (both sides seq_cst)
+        while (!m_isDraining.exchange(true)) {
+            size_t next = m_numWritten.load(std::memory_order_relaxed);
+            while (m_slots[next % m_window].finishedIdx.load(std::memory_order_acquire) == next) {
+                auto& line = m_slots[next % m_window].line;
+                m_out->write(line.data(), line.size());
+                line.clear();
+                m_numWritten.store(++next, std::memory_order_release);
+                m_numWritten.notify_all();
+            }
+            m_out->flush();
+            m_isDraining.store(false);
+            if (m_slots[next % m_window].finishedIdx.load() != next) {
+                return;
+            }
+        }
+    }
+
+    std::ostream* m_out;
+    size_t m_window;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<size_t> m_numWritten{0};
+    std::atomic<bool> m_isDraining{false};
 };
+
+} // namespace WORDLE_NAMESPACE
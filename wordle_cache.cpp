@@ -0,0 +1,189 @@
+#include "wordle_cache.h"
+#include "wordle_dictionary.h"
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+static const char CACHE_MAGIC[8] = {'W', 'O', 'R', 'D', 'L', 'E', 'C', '1'};
+static const uint32_t CACHE_VERSION = 1;
+
+static bool statFile(const string& filename, uint64_t& outSize, uint64_t& outMtime) {
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) {
+        return false;
+    }
+    outSize = st.st_size;
+    outMtime = st.st_mtime;
+    return true;
+}
+
+static uint64_t alignTo8(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+WordleCache::WordleCache(const string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(WordleCacheHeader)) {
+        close(fd);
+        return;
+    }
+
+    void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return;
+    }
+    m_base = static_cast<const char*>(mapping);
+    m_size = st.st_size;
+    m_header = reinterpret_cast<const WordleCacheHeader*>(m_base);
+
+    if (!isFresh()) {
+        if (isLogging(WordleLogLevel::INFO)) cerr << "Cache [" << filename << "] stale, loading text dictionaries" << endl;
+        m_header = nullptr;
+        return;
+    }
+    if (isLogging(WordleLogLevel::INFO)) cout << "Loaded cache: " << filename << endl;
+}
+
+WordleCache::~WordleCache() {
+    if (m_base) {
+        munmap(const_cast<char*>(m_base), m_size);
+    }
+}
+
+const WordleCache& WordleCache::getInstance() {
+    static const WordleCache cache(CACHE_FILENAME);
+    return cache;
+}
+
+bool WordleCache::isFresh() const {
+    if (memcmp(m_header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        m_header->version != CACHE_VERSION ||
+        m_header->letterCount != LETTER_COUNT ||
+        m_header->numAnswers > m_header->numGuesses) {
+        return false;
+    }
+
+    // sections must be inside the file
+    uint64_t wordsEnd = m_header->wordsOffset + m_header->numGuesses*LETTER_COUNT;
+    uint64_t scoresEnd = m_header->scoresOffset + m_header->numGuesses*sizeof(double);
+    uint64_t feedbackEnd = m_header->feedbackOffset + m_header->numGuesses*m_header->numAnswers*sizeof(feedback_t);
+    if (wordsEnd > m_size ||
+        (m_header->scoresOffset && (scoresEnd > m_size || m_header->scoresOffset % 8 != 0)) ||
+        (m_header->feedbackOffset && feedbackEnd > m_size)) {
+        return false;
+    }
+
+    // text dictionaries changed since the cache was built
+    uint64_t size, mtime;
+    if (statFile(DICTIONARY_FILENAME, size, mtime) &&
+        (size != m_header->answersFileSize || mtime != m_header->answersFileMtime)) {
+        return false;
+    }
+    if (statFile(EXTENDED_DICTIONARY_FILENAME, size, mtime) &&
+        (size != m_header->guessesFileSize || mtime != m_header->guessesFileMtime)) {
+        return false;
+    }
+
+    return true;
+}
+
+const double* WordleCache::getFirstGuessScores() const {
+    if (!isValid() || m_header->scoresOffset == 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(m_base + m_header->scoresOffset);
+}
+
+const feedback_t* WordleCache::getFeedbackTable() const {
+    if (!isValid() || m_header->feedbackOffset == 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const feedback_t*>(m_base + m_header->feedbackOffset);
+}
+
+bool WordleCache::build(const string& filename) {
+    auto header = WordleCacheHeader();
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.letterCount = LETTER_COUNT;
+    if (!statFile(DICTIONARY_FILENAME, header.answersFileSize, header.answersFileMtime) ||
+        !statFile(EXTENDED_DICTIONARY_FILENAME, header.guessesFileSize, header.guessesFileMtime)) {
+        cerr << "Error: [cache] missing text dictionary" << endl;
+        return false;
+    }
+
+    auto& matrix = WordleFeedbackMatrix::getExtendedMatrix();
+    auto& guesses = matrix.getGuessDictionary();
+    header.numAnswers = matrix.getNumAnswers();
+    header.numGuesses = matrix.getNumGuesses();
+    header.wordsOffset = alignTo8(sizeof(WordleCacheHeader));
+    header.scoresOffset = alignTo8(header.wordsOffset + header.numGuesses*LETTER_COUNT);
+    header.feedbackOffset = header.scoresOffset + header.numGuesses*sizeof(double);
+
+    // score every guess against the full answer list, same formula as the entropy selector
+    auto allAnswers = vector<size_t>(matrix.getNumAnswers());
+    for (size_t a = 0; a < allAnswers.size(); a++) {
+        allAnswers[a] = a;
+    }
+    auto scores = vector<double>(matrix.getNumGuesses());
+    uint32_t counts[FEEDBACK_PATTERNS];
+    for (size_t g = 0; g < scores.size(); g++) {
+        matrix.computeHistogram(g, allAnswers, counts);
+        double score = 0;
+        for (size_t p = 0; p < FEEDBACK_PATTERNS; p++) {
+            size_t n = counts[p];
+            score += (n == 0) ? 0 : n * log2(static_cast<double>(n));
+        }
+        scores[g] = score;
+    }
+
+    // write next to the target and rename, a running solver may have the old file mapped
+    string tmpFilename = filename + ".tmp";
+    auto fileout = ofstream(tmpFilename, ios::binary | ios::trunc);
+    auto pad = [&fileout](uint64_t offset) {
+        while (static_cast<uint64_t>(fileout.tellp()) < offset) {
+            fileout.put(0);
+        }
+    };
+    fileout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    pad(header.wordsOffset);
+    fileout.write(guesses.getLetters(0), header.numGuesses*LETTER_COUNT);
+    pad(header.scoresOffset);
+    fileout.write(reinterpret_cast<const char*>(scores.data()), scores.size()*sizeof(double));
+    pad(header.feedbackOffset);
+    fileout.write(reinterpret_cast<const char*>(matrix.getRow(0)), header.numGuesses*header.numAnswers*sizeof(feedback_t));
+    fileout.close();
+
+    if (!fileout || rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+        cerr << "Error: [cache] failed to write " << filename << endl;
+        return false;
+    }
+
+    cout << "Wrote cache: " << filename << " (" << header.numGuesses << " guesses x " << header.numAnswers << " answers)" << endl;
+    return true;
+}
+
+} // namespace WORDLE_NAMESPACE
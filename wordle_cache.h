@@ -0,0 +1,69 @@
+#pragma once
+
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+/**
+Binary cache file, written by `solver --build-cache`, mapped read-only at startup
+
+   +----------------------+
+   | WordleCacheHeader    |
+   +----------------------+  wordsOffset
+   | guess words, packed  |  numGuesses * LETTER_COUNT bytes, answers first
+   +----------------------+  scoresOffset (8-byte aligned, 0 if absent)
+   | first-guess scores   |  numGuesses doubles, sum_p c_p*log2(c_p) over all answers
+   +----------------------+  feedbackOffset (0 if absent)
+   | feedback matrix      |  numGuesses * numAnswers feedback_t
+   +----------------------+
+
+Stale (ignored, text files used instead) if the size or mtime of either text
+ dictionary no longer matches what was recorded when the cache was built.
+ */
+struct WordleCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t letterCount;
+    uint64_t answersFileSize;
+    uint64_t answersFileMtime;
+    uint64_t guessesFileSize;
+    uint64_t guessesFileMtime;
+    uint64_t numAnswers;
+    uint64_t numGuesses;
+    uint64_t wordsOffset;
+    uint64_t scoresOffset;
+    uint64_t feedbackOffset;
+};
+
+class WordleCache {
+public:
+    ~WordleCache();
+
+    // Maps CACHE_FILENAME on first use, isValid() is false when missing or stale
+    static const WordleCache& getInstance();
+    // Writes a fresh cache from the text dictionaries
+    static bool build(const string& filename=CACHE_FILENAME);
+
+    bool isValid() const { return m_header != nullptr; }
+    size_t getNumAnswers() const { return m_header->numAnswers; }
+    size_t getNumGuesses() const { return m_header->numGuesses; }
+    const char* getGuessLetters() const { return m_base + m_header->wordsOffset; }
+    // nullptr if not in the cache
+    const double* getFirstGuessScores() const;
+    const feedback_t* getFeedbackTable() const;
+private:
+    WordleCache(const string& filename);
+    bool isFresh() const;
+
+    const char* m_base{nullptr};
+    size_t m_size{0};
+    const WordleCacheHeader* m_header{nullptr};
+};
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,65 @@
+#include "wordle_candidate_filter.h"
+#include "wordle_rules.h"
+#include "wordle_selector.h"
+
+#include <bit>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+string WordleCandidateFilter::getCandidate(WordleSelector<CandidateIterator>* selector, const vector<WordleKnown>& knowns, size_t guessNum) {
+    return selector->select(m_candidates.begin(), m_candidates.end(), m_candidates.size(), knowns, guessNum);
+}
+
+void WordleCandidateFilter::applyConstraint(const WordleConstraint& constraint) {
+    // every yes/no fact is a precomputed mask, ANDed in together
+    WordleFixedVector<const WordleBitset*, 2*LETTER_COUNT> keep;
+    WordleFixedVector<const WordleBitset*, 2*LETTER_COUNT> remove;
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        if (constraint.isGreen(i)) {
+            keep.push_back(&m_dict.getPositionMask(i, static_cast<char>('a' + countr_zero(constraint.allowed[i]))));
+            continue;
+        }
+        for (uint32_t rest = constraint.getExcluded(i); rest != 0; rest &= rest - 1) {
+            remove.push_back(&m_dict.getPositionMask(i, static_cast<char>('a' + countr_zero(rest))));
+        }
+    }
+    for (uint32_t rest = constraint.presentLetters; rest != 0; rest &= rest - 1) {
+        keep.push_back(&m_dict.getLetterMask(static_cast<char>('a' + countr_zero(rest))));
+    }
+    for (uint32_t rest = constraint.absentLetters; rest != 0; rest &= rest - 1) {
+        remove.push_back(&m_dict.getLetterMask(static_cast<char>('a' + countr_zero(rest))));
+    }
+    m_candidates.filter(keep.begin(), keep.size(), remove.begin(), remove.size());
+
+    // letter counts no mask holds, checked word by word over what's left
+    if (constraint.countedLetters != 0) {
+        m_candidates.keepIf([&](size_t wordId) { return constraint.matchesCounts(m_dict.getLetters(wordId)); });
+    }
+}
+
+void WordleCandidateFilter::printCandidates() const {
+    size_t numCandidates = m_candidates.size();
+    cout << "Candidates: (Showing "
+         << ((numCandidates > PRINT_GUESSES_SIZE) ? PRINT_GUESSES_SIZE : numCandidates)
+         << ")" << endl;
+
+    size_t i = 0;
+    for (auto& cand : m_candidates) {
+        if (i == PRINT_GUESSES_SIZE) {
+            cout << "... (Skipping " << (numCandidates-PRINT_GUESSES_SIZE) << ")" << endl;
+            break;
+        }
+        cout << " " << cand << endl;
+        i++;
+    }
+}
+
+WordleCandidateFilter::WordleCandidateFilter(const WordleDictionary& dict) : m_dict(dict), m_candidates(&m_dict.getWords()) {
+}
+
+} // namespace WORDLE_NAMESPACE
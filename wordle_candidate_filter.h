@@ -0,0 +1,44 @@
+#pragma once
+
+#include "wordle_candidates.h"
+#include "wordle_constraint.h"
+#include "wordle_dictionary.h"
+#include "wordle_rules.h"
+#include "wordle_selector.h"
+#include "wordle_solver.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+ * Thin wrapper over a `WordleCandidateSet`: candidate words are a bitset indexed by dictionary word ID.
+ * Each hint is an AND/ANDNOT against the dictionary's precomputed masks, a guess's all fused into one pass:
+ *   getPositionMask(pos, letter): words with `letter` at `pos`
+ *   getLetterMask(letter):        words containing `letter` anywhere
+ * Words are looked up by the dictionary itself (WordleDictionary::getWordId).
+ * Replaced the letter trie, `--solver trie` and `TrieBasedWordleSolver` keep the old name.
+ */
+class WordleCandidateFilter {
+public:
+    WordleCandidateFilter(const WordleDictionary& dict);
+    // all of one guess's feedback as a single fused pass over the candidate bitset
+    void applyConstraint(const WordleConstraint& constraint);
+    // every dictionary word is a candidate again
+    void reset() { m_candidates.reset(); }
+    // candidates as recorded from another filter over the same dictionary
+    void setCandidates(const WordleCandidateSet& candidates) { m_candidates = candidates; }
+    string getCandidate(WordleSelector<CandidateIterator>* selector, const vector<WordleKnown>& knowns, size_t guessNum);
+    size_t getNumCandidates() const { return m_candidates.size(); }
+    const WordleCandidateSet& getCandidates() const { return m_candidates; }
+    void printCandidates() const;
+private:
+    const WordleDictionary& m_dict;
+    WordleCandidateSet m_candidates;
+};
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "wordle_rules.h"
+
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+inline size_t letterIndex(char letter) { return static_cast<size_t>(letter - 'a'); }
+static const size_t ALPHABET_SIZE = 26;
+
+/**
+ * Dense bitset indexed by word ID, one bit per word.
+ * Bulk ops run a word (64 bits) at a time over contiguous storage, so the compiler
+ *  is free to vectorize them.
+ * A second level keeps one bit per non-empty block: blocks that die are never visited
+ *  again, so ops cost O(live blocks) and shrink with the candidate set.
+ */
+class WordleBitset {
+public:
+    WordleBitset() : m_blocks(), m_liveBlocks(), m_size(0) {}
+    WordleBitset(size_t size, bool value) { resize(size, value); }
+
+    void resize(size_t size, bool value) {
+        m_size = size;
+        m_blocks.assign((size + 63) / 64, value ? ~uint64_t(0) : 0);
+        if (value && (size % 64) != 0) {
+            m_blocks.back() = (uint64_t(1) << (size % 64)) - 1;
+        }
+        m_liveBlocks.assign((m_blocks.size() + 63) / 64, 0);
+        if (value) {
+            for (size_t i = 0; i < m_blocks.size(); i++) {
+                m_liveBlocks[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+    void set(size_t idx) {
+        if (idx >= m_size) {
+            m_size = idx + 1;
+            m_blocks.resize((m_size + 63) / 64, 0);
+            m_liveBlocks.resize((m_blocks.size() + 63) / 64, 0);
+        }
+        m_blocks[idx / 64] |= uint64_t(1) << (idx % 64);
+        markLive(idx / 64);
+    }
+    void unset(size_t idx) {
+        if (idx < m_size) {
+            m_blocks[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+            updateLive(idx / 64);
+        }
+    }
+    bool test(size_t idx) const { return idx < m_size && (m_blocks[idx / 64] >> (idx % 64)) & 1; }
+
+    // this &= other
+    void andWith(const WordleBitset& other) { combineLive</*isAndNot=*/false>(other); }
+    // this &= ~other
+    void andNotWith(const WordleBitset& other) { combineLive</*isAndNot=*/true>(other); }
+    size_t count() const {
+        size_t total = 0;
+        forEachLiveBlock([&](size_t i) { total += popcount(m_blocks[i]); });
+        return total;
+    }
+    // first set bit at or after `idx`, size() if none
+    size_t findNext(size_t idx) const {
+        if (idx >= m_size) {
+            return m_size;
+        }
+        size_t blockIdx = idx / 64;
+        uint64_t block = m_blocks[blockIdx] & (~uint64_t(0) << (idx % 64));
+        if (block != 0) {
+            return blockIdx * 64 + countr_zero(block);
+        }
+
+        // skip straight to the next live block
+        size_t nextBlock = blockIdx + 1;
+        size_t summaryIdx = nextBlock / 64;
+        if (summaryIdx >= m_liveBlocks.size()) {
+            return m_size;
+        }
+        uint64_t live = m_liveBlocks[summaryIdx] & (~uint64_t(0) << (nextBlock % 64));
+        while (live == 0) {
+            if (++summaryIdx == m_liveBlocks.size()) {
+                return m_size;
+            }
+            live = m_liveBlocks[summaryIdx];
+        }
+        blockIdx = summaryIdx * 64 + countr_zero(live);
+        return blockIdx * 64 + countr_zero(m_blocks[blockIdx]);
+    }
+    // every bit set here is also set in `other`
+    bool isSubsetOf(const WordleBitset& other) const {
+        bool isSubset = true;
+        forEachLiveBlock([&](size_t i) {
+            uint64_t otherBlock = (i < other.m_blocks.size()) ? other.m_blocks[i] : 0;
+            isSubset = isSubset && !(m_blocks[i] & ~otherBlock);
+        });
+        return isSubset;
+    }
+    // fn(idx) for every bit set here but not in `other`
+    template <typename Fn>
+    void forEachNotIn(const WordleBitset& other, Fn fn) const {
+        forEachLiveBlock([&](size_t i) {
+            uint64_t block = m_blocks[i] & ~((i < other.m_blocks.size()) ? other.m_blocks[i] : 0);
+            for (; block != 0; block &= block - 1) {
+                fn(i * 64 + countr_zero(block));
+            }
+        });
+    }
+    // this &= every keep mask & ~every remove mask, fused into one pass over the live blocks
+    // (at most MAX_FILTER_MASKS of each)
+    static const size_t MAX_FILTER_MASKS = 16;
+    void filter(const WordleBitset* const* keep, size_t numKeep, const WordleBitset* const* remove, size_t numRemove) {
+        // raw block pointers up front, so the inner loop is loads and ANDs only
+        const uint64_t* keepBlocks[MAX_FILTER_MASKS];
+        const uint64_t* removeBlocks[MAX_FILTER_MASKS];
+        size_t numShared = m_blocks.size();
+        for (size_t k = 0; k < numKeep; k++) {
+            keepBlocks[k] = keep[k]->m_blocks.data();
+            numShared = (keep[k]->m_blocks.size() < numShared) ? keep[k]->m_blocks.size() : numShared;
+        }
+        for (size_t r = 0; r < numRemove; r++) {
+            removeBlocks[r] = remove[r]->m_blocks.data();
+            numShared = (remove[r]->m_blocks.size() < numShared) ? remove[r]->m_blocks.size() : numShared;
+        }
+
+        uint64_t* blocks = m_blocks.data();
+        for (size_t summaryIdx = 0; summaryIdx < m_liveBlocks.size(); summaryIdx++) {
+            uint64_t live = m_liveBlocks[summaryIdx];
+            if (live == 0) {
+                continue;
+            }
+            size_t base = summaryIdx * 64;
+            size_t end = base + 64 - countl_zero(live);
+            size_t first = base + countr_zero(live);
+            size_t sharedEnd = (end < numShared) ? end : numShared;
+            // a mask at a time over the span, each a straight loop over L1-resident blocks
+            for (size_t k = 0; k < numKeep; k++) {
+                const uint64_t* keepBlock = keepBlocks[k];
+                for (size_t i = first; i < sharedEnd; i++) {
+                    blocks[i] &= keepBlock[i];
+                }
+            }
+            for (size_t r = 0; r < numRemove; r++) {
+                const uint64_t* removeBlock = removeBlocks[r];
+                for (size_t i = first; i < sharedEnd; i++) {
+                    blocks[i] &= ~removeBlock[i];
+                }
+            }
+            uint64_t newLive = 0;
+            for (size_t i = first; i < end; i++) {
+                if (i >= sharedEnd) {
+                    for (size_t k = 0; k < numKeep; k++) {
+                        blocks[i] &= keep[k]->getBlock(i);
+                    }
+                    for (size_t r = 0; r < numRemove; r++) {
+                        blocks[i] &= ~remove[r]->getBlock(i);
+                    }
+                }
+                newLive |= uint64_t(blocks[i] != 0) << (i - base);
+            }
+            m_liveBlocks[summaryIdx] = newLive;
+        }
+    }
+    // clears every set bit where keep(idx) is false, in one pass over the live blocks
+    template <typename Pred>
+    void keepIf(Pred keep) {
+        forEachLiveBlock([&](size_t i) {
+            uint64_t block = m_blocks[i];
+            for (uint64_t rest = block; rest != 0; rest &= rest - 1) {
+                if (!keep(i * 64 + countr_zero(rest))) {
+                    block &= ~(rest & -rest);
+                }
+            }
+            m_blocks[i] = block;
+            updateLive(i);
+        });
+    }
+    size_t size() const { return m_size; }
+    // 64 bits of the set bits' positions, a different `seed` gives an independent hash
+    uint64_t hash(uint64_t seed) const {
+        uint64_t hash = seed ^ m_size;
+        forEachLiveBlock([&](size_t i) {
+            // splitmix64 finalizer over each live block and its index
+            uint64_t x = hash ^ m_blocks[i] ^ (i * 0x9E3779B97F4A7C15ull);
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            hash = x ^ (x >> 31);
+        });
+        return hash;
+    }
+private:
+    uint64_t getBlock(size_t blockIdx) const { return (blockIdx < m_blocks.size()) ? m_blocks[blockIdx] : 0; }
+    template <typename Fn>
+    void forEachLiveBlock(Fn fn) const {
+        for (size_t summaryIdx = 0; summaryIdx < m_liveBlocks.size(); summaryIdx++) {
+            for (uint64_t live = m_liveBlocks[summaryIdx]; live != 0; live &= live - 1) {
+                fn(summaryIdx * 64 + countr_zero(live));
+            }
+        }
+    }
+    // ANDs over the span of live blocks under each summary word as one straight loop,
+    //  dead blocks inside a span just stay 0
+    template <bool isAndNot>
+    void combineLive(const WordleBitset& other) {
+        uint64_t* blocks = m_blocks.data();
+        const uint64_t* otherBlocks = other.m_blocks.data();
+        size_t numShared = (m_blocks.size() < other.m_blocks.size()) ? m_blocks.size() : other.m_blocks.size();
+        for (size_t summaryIdx = 0; summaryIdx < m_liveBlocks.size(); summaryIdx++) {
+            uint64_t live = m_liveBlocks[summaryIdx];
+            if (live == 0) {
+                continue;
+            }
+            size_t base = summaryIdx * 64;
+            size_t first = base + countr_zero(live);
+            size_t end = base + 64 - countl_zero(live);
+            size_t sharedEnd = (end < numShared) ? end : numShared;
+            uint64_t newLive = 0;
+            for (size_t i = first; i < sharedEnd; i++) {
+                uint64_t block = isAndNot ? (blocks[i] & ~otherBlocks[i]) : (blocks[i] & otherBlocks[i]);
+                blocks[i] = block;
+                newLive |= uint64_t(block != 0) << (i - base);
+            }
+            for (size_t i = (first > sharedEnd) ? first : sharedEnd; i < end; i++) {
+                if (isAndNot) {
+                    newLive |= uint64_t(blocks[i] != 0) << (i - base);
+                } else {
+                    blocks[i] = 0;
+                }
+            }
+            m_liveBlocks[summaryIdx] = newLive;
+        }
+    }
+    void markLive(size_t blockIdx) { m_liveBlocks[blockIdx / 64] |= uint64_t(1) << (blockIdx % 64); }
+    void updateLive(size_t blockIdx) {
+        if (m_blocks[blockIdx] == 0) {
+            m_liveBlocks[blockIdx / 64] &= ~(uint64_t(1) << (blockIdx % 64));
+        }
+    }
+
+    vector<uint64_t> m_blocks;
+    vector<uint64_t> m_liveBlocks; // bit per block, set if the block has any bit set
+    size_t m_size;
+};
+
+/**
+ * Walks the set bits of a `WordleBitset`, yielding the word with that ID.
+ * Same shape as `SetIterator` so the selectors can consume it unchanged.
+ */
+class CandidateIterator {
+public:
+    using iterator_category = forward_iterator_tag;
+    using value_type = string;
+    using difference_type = ptrdiff_t;
+    using pointer = const string*;
+    using reference = const string&;
+
+    CandidateIterator() : m_bits(nullptr), m_words(nullptr), m_idx(0) {}
+    CandidateIterator(const WordleBitset* bits, const vector<string>* words, size_t idx)
+        : m_bits(bits), m_words(words), m_idx(bits->findNext(idx)) {}
+
+    reference operator*() const { return (*m_words)[m_idx]; }
+    pointer operator->() const { return &(*m_words)[m_idx]; }
+    CandidateIterator& operator++() { m_idx = m_bits->findNext(m_idx + 1); return *this; }
+    CandidateIterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+    bool operator==(const CandidateIterator& other) const { return m_idx == other.m_idx; }
+    bool operator!=(const CandidateIterator& other) const { return m_idx != other.m_idx; }
+    size_t getWordId() const { return m_idx; }
+    const WordleBitset* getBits() const { return m_bits; }
+    const vector<string>* getWords() const { return m_words; }
+private:
+    const WordleBitset* m_bits;
+    const vector<string>* m_words;
+    size_t m_idx;
+};
+
+/**
+ * Live words out of a fixed word list.
+ */
+class WordleCandidateSet {
+public:
+    WordleCandidateSet() : m_words(nullptr), m_bits() {}
+    WordleCandidateSet(const vector<string>* words) : m_words(words), m_bits(words->size(), true) {}
+
+    CandidateIterator begin() const { return CandidateIterator(&m_bits, m_words, 0); }
+    CandidateIterator end() const { return CandidateIterator(&m_bits, m_words, m_bits.size()); }
+    size_t size() const { return m_bits.count(); }
+
+    void insert(size_t wordId) { m_bits.set(wordId); }
+    void erase(size_t wordId) { m_bits.unset(wordId); }
+    bool contains(size_t wordId) const { return m_bits.test(wordId); }
+    void keepOnly(const WordleBitset& mask) { m_bits.andWith(mask); }
+    void remove(const WordleBitset& mask) { m_bits.andNotWith(mask); }
+    void filter(const WordleBitset* const* keep, size_t numKeep, const WordleBitset* const* remove, size_t numRemove) {
+        m_bits.filter(keep, numKeep, remove, numRemove);
+    }
+    template <typename Pred>
+    void keepIf(Pred keep) { m_bits.keepIf(keep); }
+    void setWords(const vector<string>* words) { m_words = words; }
+    uint64_t hash(uint64_t seed) const { return m_bits.hash(seed); }
+    // every word live again, reusing the storage
+    void reset() { m_bits.resize(m_words->size(), true); }
+private:
+    const vector<string>* m_words;
+    WordleBitset m_bits;
+};
+
+} // namespace WORDLE_NAMESPACE
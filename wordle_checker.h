@@ -1,18 +1,20 @@
 #pragma once
 
+#include "wordle_feedback.h"
+#include "wordle_hard_mode.h"
 #include "wordle_rules.h"
 
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+
+namespace WORDLE_NAMESPACE {
 
 
 class WordleChecker {
 public:
-    WordleChecker() : m_numGuesses(0) { loadDictionary(); }
+    WordleChecker() : m_numGuesses(0), m_matrix(WordleFeedbackMatrix::getAnswersMatrix()) {}
     /**
       * true:  operation was success, answer is set
-      * false: input word not in dictionary
+      * false: input word not in dictionary, or breaks hard mode
       * throws if dictionary empty or (guess or answer) isn't correct length
       */
     bool check(WordleGuess& wg, size_t& outNumGuesses);
@@ -23,12 +25,18 @@ public:
       */
     bool setAnswer(std::string answer);
     void setRandomAnswer();
+    // Rejects guesses that don't reuse every hint revealed so far
+    void setHardMode(bool isHardMode) { m_isHardMode = isHardMode; }
 private:
-    void resetFrequencyMap();
-    void loadDictionary(std::string filename=DICTIONARY_FILENAME);
+    feedback_t getFeedback(size_t guessIdx) const;
 
-    std::unordered_set<std::string> m_dict;
     std::string m_answer;
+    size_t m_answerIdx;
+    bool m_isAnswerInMatrix{false};
     size_t m_numGuesses;
-    std::unordered_map<char, size_t> m_frequencyMap;
+    bool m_isHardMode{false};
+    WordleHardRules m_hardRules;
+    const WordleFeedbackMatrix& m_matrix;
 };
+
+} // namespace WORDLE_NAMESPACE
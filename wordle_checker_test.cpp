@@ -1,12 +1,37 @@
+#include "game_modes.h"
+#include "wordle_alloc_counter.h"
+#include "wordle_batch.h"
+#include "wordle_buffer.h"
+#include "wordle_candidate_filter.h"
 #include "wordle_checker.h"
+#include "wordle_constraint.h"
+#include "wordle_feedback.h"
+#include "wordle_hard_mode.h"
+#include "wordle_multi_board.h"
+#include "wordle_openers.h"
 #include "wordle_rules.h"
+#include "wordle_selector.h"
+#include "wordle_state_cache.h"
+#include "wordle_thread_pool.h"
+#include "wordle_transposition_table.h"
+#include "wordlist_wordle_solver.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
 
 using namespace std;
+// the 5-letter engine, wordle_core_5
+using namespace WORDLE_NAMESPACE;
 
 
 int main() {
+    // only failures print
+    g_log_level = WordleLogLevel::QUIET;
+
     auto wc = WordleChecker{};
     wc.setAnswer("quiet");
 
@@ -15,7 +40,7 @@ int main() {
     if (!wc.check(wg1, numGuesses)) {
         cerr << "failure" << endl;
     }
-    if (wg1.results != vector<WordleResult>{WordleResult::BLACK, WordleResult::BLACK, WordleResult::GREEN, WordleResult::BLACK, WordleResult::YELLOW}) {
+    if (wg1.results != WordleResults{WordleResult::BLACK, WordleResult::BLACK, WordleResult::GREEN, WordleResult::BLACK, WordleResult::YELLOW}) {
         cerr << "failure" << endl;
     }
 
@@ -23,30 +48,428 @@ int main() {
     if (!wc.check(wg2, numGuesses)) {
         cerr << "failure" << endl;
     }
-    if (wg2.results != vector<WordleResult>{WordleResult::GREEN, WordleResult::GREEN, WordleResult::YELLOW, WordleResult::BLACK, WordleResult::BLACK}) { // which e gets the color??
+    if (wg2.results != WordleResults{WordleResult::GREEN, WordleResult::GREEN, WordleResult::BLACK, WordleResult::GREEN, WordleResult::BLACK}) { // greens take precedence
         cerr << "failure" << endl;
     }
 
+    // not an answer, but an allowed guess from the extended dictionary
     auto wg3 = WordleGuess{"moles"};
-    if (wc.check(wg3, numGuesses)) {
+    if (!wc.check(wg3, numGuesses)) {
         cerr << "failure" << endl;
     }
-    if (wg3.results != vector<WordleResult>{WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK, WordleResult::GREEN, WordleResult::BLACK}) {
+    if (wg3.results != WordleResults{WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK, WordleResult::GREEN, WordleResult::BLACK}) {
         cerr << "failure" << endl;
     }
 
+    // in neither dictionary
     auto wg4 = WordleGuess{"zzzzz"};
     if (wc.check(wg4, numGuesses)) {
         cerr << "failure" << endl;
     }
 
     auto wg5 = WordleGuess{"slams"};
-    if (wc.check(wg5, numGuesses)) {
+    if (!wc.check(wg5, numGuesses)) {
+        cerr << "failure" << endl;
+    }
+    if (wg5.results != WordleResults{WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK}) {
+        cerr << "failure" << endl;
+    }
+
+    // feedback matrix must agree with direct computation
+    if (computeFeedback("quiet", "quiet") != CORRECT_FEEDBACK) {
+        cerr << "failure" << endl;
+    }
+    if (decodeFeedback(computeFeedback("alive", "quiet")) != wg1.results) {
+        cerr << "failure" << endl;
+    }
+    if (encodeFeedback(wg2.results) != computeFeedback("queen", "quiet")) {
+        cerr << "failure" << endl;
+    }
+    if (computeFeedback("leeen", "sweet") != encodeFeedback({WordleResult::BLACK, WordleResult::BLACK, WordleResult::GREEN, WordleResult::GREEN, WordleResult::BLACK})) {
+        cerr << "failure" << endl;
+    }
+
+    auto& matrix = WordleFeedbackMatrix::getAnswersMatrix();
+    size_t guessIdx, answerIdx;
+    if (!matrix.getGuessIndex("alive", guessIdx) || !matrix.getAnswerIndex("quiet", answerIdx)) {
+        cerr << "failure" << endl;
+    } else if (matrix.lookup(guessIdx, answerIdx) != computeFeedback("alive", "quiet")) {
+        cerr << "failure" << endl;
+    }
+
+    // once warm, a reused solver plays whole games without touching the heap
+    if (isCountingHeapAllocs()) {
+        auto solver = TrieBasedWordleSolver();
+        auto wb = make_shared<WordleBuffer>();
+        WordleSweepStats stats;
+        // every answer, a scratch buffer that grows with the biggest range seen shows up past the first few
+        size_t numGames = matrix.getNumAnswers();
+        for (size_t i = 0; i < numGames; i++) {
+            runReusedGame(&solver, /*isWarm=*/i > 0, matrix.getAnswer(i), i+1, wb, &stats);
+        }
+        if (stats.steadyStateAllocs != 0) {
+            cerr << "failure" << endl;
+        }
+    }
+
+    // a warm pool runs every item exactly once, and deals its chunks without touching the heap
+    auto pool = WordleThreadPool(4);
+    auto poolHits = vector<size_t>(1000, 0);
+    WordleThreadPool::Task countHits = [&poolHits](size_t unused_workerIdx, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            poolHits[i]++;
+        }
+    };
+    pool.run(poolHits.size(), 10, countHits);
+    size_t poolAllocsBefore = getThreadHeapAllocs();
+    pool.run(poolHits.size(), 10, countHits);
+    if ((isCountingHeapAllocs() && getThreadHeapAllocs() != poolAllocsBefore) ||
+        any_of(poolHits.begin(), poolHits.end(), [](size_t hits) { return hits != 2; })) {
+        cerr << "failure" << endl;
+    }
+
+    // bitset ops skipping dead blocks agree with a plain vector<bool>
+    size_t numBits = 64*70 + 13;
+    auto bits = WordleBitset(numBits, true);
+    auto expected = vector<bool>(numBits, true);
+    for (size_t round = 0; round < 8; round++) {
+        auto mask = WordleBitset(numBits, false);
+        for (size_t i = round; i < numBits; i += 3 + round) {
+            mask.set(i);
+        }
+        if (round % 2 == 0) {
+            bits.andWith(mask);
+        } else {
+            bits.andNotWith(mask);
+        }
+        for (size_t i = 0; i < numBits; i++) {
+            expected[i] = expected[i] && (mask.test(i) == (round % 2 == 0));
+        }
+        size_t numExpected = 0;
+        size_t next = bits.findNext(0);
+        for (size_t i = 0; i < numBits; i++) {
+            if (bits.test(i) != expected[i]) {
+                cerr << "failure" << endl;
+            }
+            if (expected[i]) {
+                numExpected++;
+                if (next != i) {
+                    cerr << "failure" << endl;
+                }
+                next = bits.findNext(i + 1);
+            }
+        }
+        if (next != numBits || bits.count() != numExpected) {
+            cerr << "failure" << endl;
+        }
+    }
+
+    // a compiled constraint keeps exactly the answers that would give the same feedback
+    auto& answers = WordleDictionary::getAnswers();
+    auto answersFilter = WordleCandidateFilter(answers);
+    for (auto& guessStr : {"salet", "eerie", "llama", "sassy", "abbey", "geese"}) {
+        for (size_t answerIdx = 0; answerIdx < answers.size(); answerIdx += 7) {
+            feedback_t feedback = computeFeedback(guessStr, answers.getLetters(answerIdx));
+            auto constraint = WordleConstraint(WordleGuess(guessStr, decodeFeedback(feedback)));
+            size_t numSameFeedback = 0;
+            for (size_t wordId = 0; wordId < answers.size(); wordId++) {
+                bool isSameFeedback = computeFeedback(guessStr, answers.getLetters(wordId)) == feedback;
+                numSameFeedback += isSameFeedback;
+                if (constraint.matches(answers.getLetters(wordId)) != isSameFeedback) {
+                    cerr << "failure" << endl;
+                }
+            }
+            answersFilter.reset();
+            answersFilter.applyConstraint(constraint);
+            if (answersFilter.getNumCandidates() != numSameFeedback) {
+                cerr << "failure" << endl;
+            }
+        }
+    }
+
+    // hard mode rejects guesses that drop a hint, and its masks allow exactly what the rules do
+    auto hardChecker = WordleChecker{};
+    hardChecker.setAnswer("quiet");
+    hardChecker.setHardMode(true);
+    size_t numHardGuesses = 0;
+    auto hardGuess = WordleGuess{"alive"};
+    if (!hardChecker.check(hardGuess, numHardGuesses)) {
+        cerr << "failure" << endl;
+    }
+    auto droppedHint = WordleGuess{"cloud"};
+    auto keptHints = WordleGuess{"spite"};
+    if (hardChecker.check(droppedHint, numHardGuesses) || !hardChecker.check(keptHints, numHardGuesses)) {
+        cerr << "failure" << endl;
+    }
+    auto hardMode = WordleHardMode(WordleDictionary::getGuesses());
+    for (auto& guessStr : {"alive", "eerie", "geese"}) {
+        hardMode.addResult(WordleConstraint(WordleGuess(guessStr, decodeFeedback(computeFeedback(guessStr, "sheep")))));
+        for (size_t wordId = 0; wordId < WordleDictionary::getGuesses().size(); wordId++) {
+            if (hardMode.isAllowed(wordId) != hardMode.getRules().allows(WordleDictionary::getGuesses().getLetters(wordId))) {
+                cerr << "failure" << endl;
+            }
+        }
+    }
+    if (hardMode.getNumAllowed() == 0 || !hardMode.getRules().allows("sheep")) {
+        cerr << "failure" << endl;
+    }
+
+    // a multi-board guess only narrows the board it was checked against, and a game solves every board
+    auto multiSolver = WordleMultiBoardSolver(4);
+    multiSolver.processResult(1, WordleGuess("salet", decodeFeedback(computeFeedback("salet", "quiet"))));
+    if (multiSolver.getNumCandidates(0) != WordleDictionary::getAnswers().size() ||
+        multiSolver.getNumCandidates(1) >= WordleDictionary::getAnswers().size()) {
+        cerr << "failure" << endl;
+    }
+    multiSolver.reset();
+    size_t multiAnswers[] = {0, 500, 1000, 2000};
+    if (!runMultiBoardGame(&multiSolver, multiAnswers, 1, make_shared<WordleBuffer>(), nullptr)) {
+        cerr << "failure" << endl;
+    }
+
+    // rows finished out of order by several threads come out in index order through a small window
+    auto sinkOut = ostringstream();
+    auto sink = make_shared<WordleBuffer>(&sinkOut, /*window=*/3);
+    auto sinkThreads = vector<thread>();
+    string sinkExpected;
+    for (size_t row = 0; row < 200; row++) {
+        sinkExpected += "row" + to_string(row) + "\n";
+    }
+    for (size_t t = 0; t < 4; t++) {
+        sinkThreads.push_back(thread([sink, t]() {
+            for (size_t row = t; row < 200; row += 4) {
+                sink->write("row", row);
+                sink->write(to_string(row), row, /*newline=*/true);
+                sink->finishLine(row);
+            }
+        }));
+    }
+    for (auto& sinkThread : sinkThreads) {
+        sinkThread.join();
+    }
+    if (sinkOut.str() != sinkExpected || sink->getNumWritten() != 200) {
+        cerr << "failure" << endl;
+    }
+
+    // batch rows come out in input order through a window smaller than the input, padding trimmed, bad answers flagged
+    auto batchIn = istringstream("cloth\n  quiet \r\n\nxx\nabbey\nzzzzz\nab ide\nzesty\n");
+    auto batchOut = ostringstream();
+    auto pipeline = WordleBatchPipeline("trie", "", /*isHardMode=*/false, /*numWorkers=*/3, /*window=*/2);
+    if (pipeline.run(batchIn, batchOut) != 7 || pipeline.getNumSuccesses() != 4) {
+        cerr << "failure" << endl;
+    }
+    auto batchRows = vector<string>();
+    auto rows = istringstream(batchOut.str());
+    for (string line; getline(rows, line);) {
+        batchRows.push_back(line.substr(line.rfind(',') + 1));
+    }
+    if (batchRows != vector<string>{"answer", "cloth", "quiet", "xx", "abbey", "zzzzz", "ab ide", "zesty"}) {
+        cerr << "failure" << endl;
+    }
+
+    // games sharing a state cache play exactly what they'd play alone, and reuse what earlier games reached
+    auto cachedOut = ostringstream();
+    auto uncachedOut = ostringstream();
+    auto cachedWb = make_shared<WordleBuffer>(&cachedOut);
+    auto uncachedWb = make_shared<WordleBuffer>(&uncachedOut);
+    auto stateCache = make_shared<WordleStateCache>(WordleDictionary::getAnswers());
+    auto cachedSolver = TrieBasedWordleSolver();
+    auto uncachedSolver = TrieBasedWordleSolver();
+    cachedSolver.setStateCache(stateCache);
+    auto& cacheAnswers = WordleDictionary::getAnswers();
+    for (size_t i = 0; i < cacheAnswers.size(); i++) {
+        runReusedGame(&cachedSolver, /*isWarm=*/false, cacheAnswers.getWord(i), i, cachedWb, nullptr);
+        runReusedGame(&uncachedSolver, /*isWarm=*/false, cacheAnswers.getWord(i), i, uncachedWb, nullptr);
+    }
+    if (cachedOut.str() != uncachedOut.str() || stateCache->getNumNodes() < 2 ||
+        stateCache->findChild(stateCache->getRoot(), computeFeedback("oater", cacheAnswers.getWord(0))) == WordleStateCache::NO_NODE) {
+        cerr << "failure" << endl;
+    }
+
+    // a full set drops its least recently used pick, greens and guess number are part of the key
+    auto smallTable = WordleTranspositionTable(/*maxEntries=*/WordleTranspositionTable::NUM_WAYS, /*numShards=*/1);
+    auto tableCandidates = WordleCandidateSet(&cacheAnswers.getWords());
+    auto noGreens = vector<WordleKnown>(LETTER_COUNT, {char(), WordleResult::BLACK});
+    auto tableKeys = vector<WordleTranspositionTable::Key>();
+    for (size_t i = 0; i <= WordleTranspositionTable::NUM_WAYS; i++) {
+        tableCandidates.erase(i);
+        tableKeys.push_back(WordleTranspositionTable::makeKey(tableCandidates, noGreens, 1));
+        smallTable.insert(tableKeys.back(), cacheAnswers.getWord(i));
+        string found;
+        if (i == 1 && (!smallTable.find(tableKeys[0], found) || found != cacheAnswers.getWord(0))) {
+            cerr << "failure" << endl;
+        }
+    }
+    auto greens = noGreens;
+    greens[0] = {'s', WordleResult::GREEN};
+    string tableGuess;
+    if (smallTable.find(tableKeys[1], tableGuess) || !smallTable.find(tableKeys[0], tableGuess) ||
+        smallTable.find(WordleTranspositionTable::makeKey(tableCandidates, greens, 1), tableGuess) ||
+        smallTable.find(WordleTranspositionTable::makeKey(tableCandidates, noGreens, 2), tableGuess) ||
+        !smallTable.find(WordleTranspositionTable::makeKey(tableCandidates, noGreens, 1), tableGuess) ||
+        tableGuess != cacheAnswers.getWord(WordleTranspositionTable::NUM_WAYS)) {
+        cerr << "failure" << endl;
+    }
+
+    // picks reused across openers play exactly what the selector would
+    auto table = make_shared<WordleTranspositionTable>();
+    auto tableSolver = TrieBasedWordleSolver();
+    tableSolver.setTranspositionTable(table);
+    auto tableOut = ostringstream();
+    auto plainOut = ostringstream();
+    auto tableWb = make_shared<WordleBuffer>(&tableOut);
+    auto plainWb = make_shared<WordleBuffer>(&plainOut);
+    for (auto opener : {"oater", "trace"}) {
+        tableSolver.setOpener(opener);
+        uncachedSolver.setOpener(opener);
+        for (size_t i = 0; i < cacheAnswers.size(); i += 3) {
+            runReusedGame(&tableSolver, /*isWarm=*/false, cacheAnswers.getWord(i), i, tableWb, nullptr);
+            runReusedGame(&uncachedSolver, /*isWarm=*/false, cacheAnswers.getWord(i), i, plainWb, nullptr);
+        }
+    }
+    auto tableSummary = ostringstream();
+    table->print(tableSummary);
+    if (tableOut.str() != plainOut.str() || tableSummary.str().find("reused: 0/") != string::npos) {
+        cerr << "failure" << endl;
+    }
+
+    // dictionary finds every word by its ID, and nothing else
+    auto& guesses = WordleDictionary::getGuesses();
+    for (size_t wordId = 0; wordId < guesses.size(); wordId++) {
+        size_t foundId;
+        if (!guesses.getWordId(guesses.getWord(wordId), foundId) || foundId != wordId) {
+            cerr << "failure" << endl;
+        }
+    }
+    if (guesses.contains("zzzzz") || guesses.contains("abc")) {
+        cerr << "failure" << endl;
+    }
+
+    // letter counts kept up as candidates drop out match a recount of what's left
+    auto candidates = WordleCandidateSet(&WordleDictionary::getAnswers().getWords());
+    auto selector = FrequencyAndPositionalLetterWordleSelector<CandidateIterator>();
+    auto noKnowns = vector<WordleKnown>(LETTER_COUNT);
+    for (size_t guessNum = 0; candidates.size() > 1; guessNum++) {
+        selector.select(candidates.begin(), candidates.end(), candidates.size(), noKnowns, guessNum);
+        if (!(selector.getLetterCounts() == WordleLetterCounts::count(candidates.begin(), candidates.end()))) {
+            cerr << "failure" << endl;
+        }
+        for (auto it = candidates.begin(); it != candidates.end(); it++) {
+            if (it->find('e') != string::npos || (it.getWordId() % 3) == guessNum % 3) {
+                candidates.erase(it.getWordId());
+            }
+        }
+    }
+
+    // column kernels count and score every word the way a walk over its letters does
+    auto columns = WordleLetterColumns();
+    columns.assign(candidates.begin(), candidates.end());
+    columns.assign(guesses.getWords().begin(), guesses.getWords().end());
+    if (!(columns.count() == WordleLetterCounts::count(guesses.getWords().begin(), guesses.getWords().end()))) {
+        cerr << "failure" << endl;
+    }
+    auto weights = WordleLetterWeights();
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        for (size_t c = 0; c < ALPHABET_SIZE; c++) {
+            weights.positions[i][c] = static_cast<uint32_t>((i * 31 + c * 7) % 53);
+        }
+    }
+    auto columnScores = vector<uint32_t>();
+    for (bool isRepeatScored : {false, true}) {
+        weights.isRepeatScored = isRepeatScored;
+        columns.score(weights, columnScores);
+        for (size_t w = 0; w < guesses.size(); w++) {
+            const string& word = guesses.getWord(w);
+            uint32_t expected = 0;
+            for (size_t i = 0; i < LETTER_COUNT; i++) {
+                if (isRepeatScored || word.find(word[i]) == i) {
+                    expected += weights.positions[i][letterIndex(word[i])];
+                }
+            }
+            if (columnScores[w] != expected) {
+                cerr << "failure" << endl;
+                break;
+            }
+        }
+    }
+
+    // the top-k pass picks the highest score, first alphabetically on ties, traced or not
+    auto naiveSelector = NaiveMostCommonLetterWordleSelector<CandidateIterator>();
+    auto allCandidates = WordleCandidateSet(&WordleDictionary::getAnswers().getWords());
+    auto allCounts = WordleLetterCounts::count(allCandidates.begin(), allCandidates.end());
+    string expectedBest;
+    size_t bestScore = 0;
+    for (auto it = allCandidates.begin(); it != allCandidates.end(); it++) {
+        size_t score = 0;
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            score += (it->find((*it)[i]) == i) ? allCounts.letters[letterIndex((*it)[i])] : 0;
+        }
+        if (expectedBest.empty() || score > bestScore || (score == bestScore && *it < expectedBest)) {
+            expectedBest = *it;
+            bestScore = score;
+        }
+    }
+    // the ranked list TRACE prints is dropped, only the pick is checked
+    auto savedLogLevel = g_log_level;
+    auto traceOut = stringstream();
+    auto* savedCout = cout.rdbuf(traceOut.rdbuf());
+    for (auto logLevel : {WordleLogLevel::INFO, WordleLogLevel::TRACE}) {
+        g_log_level = logLevel;
+        if (naiveSelector.select(allCandidates.begin(), allCandidates.end(), allCandidates.size(), noKnowns, 0) != expectedBest) {
+            cerr << "failure" << endl;
+        }
+    }
+    cout.rdbuf(savedCout);
+    g_log_level = savedLogLevel;
+
+    // minimax's pruned search finds the smallest largest partition a full count does
+    auto& extended = WordleFeedbackMatrix::getExtendedMatrix();
+    auto narrowed = WordleCandidateSet(&WordleDictionary::getAnswers().getWords());
+    narrowed.remove(WordleDictionary::getAnswers().getLetterMask('e'));
+    narrowed.remove(WordleDictionary::getAnswers().getLetterMask('a'));
+    auto narrowedIdxs = vector<size_t>();
+    for (auto it = narrowed.begin(); it != narrowed.end(); it++) {
+        narrowedIdxs.push_back(it.getWordId());
+    }
+    auto largestPartition = [&](size_t guessIdx) {
+        uint32_t counts[FEEDBACK_PATTERNS];
+        extended.computeHistogram(guessIdx, narrowedIdxs, counts);
+        return *max_element(counts, counts + FEEDBACK_PATTERNS);
+    };
+    uint32_t fewestLeft = UINT32_MAX;
+    for (size_t g = 0; g < extended.getNumGuesses(); g++) {
+        fewestLeft = min(fewestLeft, largestPartition(g));
+    }
+    auto minimax = MinimaxWordleSelector<CandidateIterator>();
+    size_t minimaxIdx;
+    if (!extended.getGuessIndex(minimax.select(narrowed.begin(), narrowed.end(), narrowed.size(), noKnowns, 1), minimaxIdx) ||
+        largestPartition(minimaxIdx) != fewestLeft) {
+        cerr << "failure" << endl;
+    }
+
+    // openers come ranked by entropy, and the best swept one survives a save/load for its selector only
+    auto openers = WordleOpeners::score(WordleSelectorType::FrequencyAndPositionalLetter);
+    auto allAnswers = vector<size_t>(extended.getNumAnswers());
+    for (size_t a = 0; a < allAnswers.size(); a++) {
+        allAnswers[a] = a;
+    }
+    uint32_t topCounts[FEEDBACK_PATTERNS];
+    extended.computeHistogram(openers.getScore(0).guess, allAnswers, topCounts);
+    if (openers.getNumScores() != extended.getNumGuesses() ||
+        openers.getScore(0).entropy < openers.getScore(1).entropy ||
+        openers.getScore(0).worstCase != *max_element(topCounts, topCounts + FEEDBACK_PATTERNS)) {
         cerr << "failure" << endl;
     }
-    if (wg5.results != vector<WordleResult>{WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK, WordleResult::BLACK}) {
+    openers.setSweep(0, 3*extended.getNumAnswers(), extended.getNumAnswers(), 0);
+    openers.setSweep(1, 4*extended.getNumAnswers(), extended.getNumAnswers(), 0);
+    auto reloaded = WordleOpeners::getInstance();
+    string bestOpener;
+    if (!openers.save("wordle.openers.test") || !reloaded.load("wordle.openers.test") ||
+        reloaded.getNumSwept() != 2 || !reloaded.getBestFor(WordleSelectorType::FrequencyAndPositionalLetter, bestOpener) ||
+        bestOpener != openers.getGuess(0) || reloaded.getBestFor(WordleSelectorType::Entropy, bestOpener)) {
         cerr << "failure" << endl;
     }
+    remove("wordle.openers.test");
 }
 
 
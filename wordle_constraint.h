@@ -0,0 +1,112 @@
+#pragma once
+
+#include "wordle_candidates.h"
+#include "wordle_rules.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+ * Everything one guess's feedback says about the answer:
+ *   allowed[i]:     letters still possible at position i, a bit per letter
+ *   presentLetters: letters the answer holds at least once (green or yellow somewhere)
+ *   absentLetters:  letters only ever seen black, struck from every position
+ *   minCount/maxCount[c]: copies of c the answer holds, checked for countedLetters only,
+ *                   the letters a yes/no can't capture (two+ copies, or a black copy next
+ *                   to a green/yellow one, which pins the count exactly)
+ * Exact: a word matches iff it would have given the same feedback to the guess.
+ */
+struct WordleConstraint {
+    WordleConstraint(const WordleGuess& guess) {
+        fill(begin(allowed), end(allowed), ALL_LETTERS);
+        fill(begin(maxCount), end(maxCount), static_cast<uint8_t>(LETTER_COUNT));
+
+        uint32_t blackLetters = 0;
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            size_t letter = letterIndex(guess.guessStr[i]);
+            uint32_t bit = uint32_t(1) << letter;
+            switch (guess.results[i]) {
+            case WordleResult::GREEN:
+                allowed[i] = bit;
+                minCount[letter]++;
+                break;
+            case WordleResult::YELLOW:
+                allowed[i] &= ~bit;
+                minCount[letter]++;
+                break;
+            case WordleResult::BLACK:
+                allowed[i] &= ~bit;
+                blackLetters |= bit;
+                break;
+            }
+        }
+
+        for (size_t letter = 0; letter < ALPHABET_SIZE; letter++) {
+            uint32_t bit = uint32_t(1) << letter;
+            if (blackLetters & bit) {
+                maxCount[letter] = minCount[letter];
+            }
+            if (minCount[letter] > 0) {
+                presentLetters |= bit;
+            } else if (blackLetters & bit) {
+                absentLetters |= bit;
+            }
+            if (minCount[letter] > 1 || (minCount[letter] > 0 && (blackLetters & bit))) {
+                countedLetters |= bit;
+            }
+        }
+        for (auto& positionMask : allowed) {
+            positionMask &= ~absentLetters;
+        }
+    }
+
+    // letters ruled out at non-green position i on their own, not because they're absent altogether
+    uint32_t getExcluded(size_t i) const { return ALL_LETTERS & ~allowed[i] & ~absentLetters; }
+    bool isGreen(size_t i) const { return popcount(allowed[i]) == 1; }
+
+    bool matches(const char* letters) const {
+        uint32_t wordLetters = 0;
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            uint32_t bit = uint32_t(1) << letterIndex(letters[i]);
+            if (!(allowed[i] & bit)) {
+                return false;
+            }
+            wordLetters |= bit;
+        }
+        if ((wordLetters & presentLetters) != presentLetters) {
+            return false;
+        }
+        return matchesCounts(letters);
+    }
+
+    bool matchesCounts(const char* letters) const {
+        for (uint32_t rest = countedLetters; rest != 0; rest &= rest - 1) {
+            size_t letter = countr_zero(rest);
+            size_t numOccurs = 0;
+            for (size_t i = 0; i < LETTER_COUNT; i++) {
+                numOccurs += (letterIndex(letters[i]) == letter);
+            }
+            if (numOccurs < minCount[letter] || numOccurs > maxCount[letter]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static const uint32_t ALL_LETTERS = (uint32_t(1) << ALPHABET_SIZE) - 1;
+
+    uint32_t allowed[LETTER_COUNT];
+    uint32_t presentLetters{0};
+    uint32_t absentLetters{0};
+    uint32_t countedLetters{0};
+    uint8_t minCount[ALPHABET_SIZE]{};
+    uint8_t maxCount[ALPHABET_SIZE];
+};
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,366 @@
+#include "wordle_decision_tree.h"
+#include "wordle_dictionary.h"
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+#include "wordle_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+static const char TREE_MAGIC[8] = {'W', 'O', 'R', 'D', 'L', 'E', 'T', '1'};
+static const uint32_t TREE_VERSION = 1;
+// Cost of a state that can't be solved within MAX_GUESSES, also the "no bound" bound
+static const uint32_t TREE_INFEASIBLE = UINT32_MAX / 4;
+
+// Pointer-based tree used while searching, flattened once the search is done
+struct WordleTreeBuildNode {
+    uint16_t guess;
+    vector<pair<feedback_t, unique_ptr<WordleTreeBuildNode>>> children;
+};
+
+/**
+ * Minimum total guesses search, one instance per thread.
+ *   cost(answers) = |answers| + sum over feedback buckets b (except all-green) of cost(b)
+ * No state of n answers can cost less than 2n-1 (at most one answer is found right away),
+ *  which bounds both whole states and the buckets not yet searched.
+ */
+class WordleTreeSearch {
+public:
+    WordleTreeSearch(const WordleFeedbackMatrix& matrix, const vector<double>& weightedLogs)
+        : m_matrix(matrix), m_weightedLogs(weightedLogs), m_isAnswer(matrix.getNumAnswers(), false) {}
+
+    // Returns >= `bound` if no tree under `bound` exists, `outNode` is only set otherwise
+    uint32_t solve(const vector<uint16_t>& answers, size_t guessesLeft, uint32_t bound, unique_ptr<WordleTreeBuildNode>& outNode);
+    uint32_t solveWithGuess(uint16_t guess, const vector<uint16_t>& answers, size_t guessesLeft, uint32_t bound, unique_ptr<WordleTreeBuildNode>& outNode);
+    // Best `maxGuesses` guesses by entropy, plus the best candidate if none made the cut
+    void rankGuesses(const vector<uint16_t>& answers, size_t maxGuesses, vector<uint16_t>& outGuesses);
+private:
+    static uint32_t lowerBound(size_t numAnswers) { return (numAnswers == 1) ? 1 : 2*numAnswers - 1; }
+
+    struct RankedGuess {
+        double score;
+        bool isCandidate;
+        uint16_t guess;
+        bool operator<(const RankedGuess& other) const {
+            if (score != other.score) return score < other.score;
+            if (isCandidate != other.isCandidate) return isCandidate;
+            return guess < other.guess;
+        }
+    };
+
+    const WordleFeedbackMatrix& m_matrix;
+    const vector<double>& m_weightedLogs;
+    uint32_t m_counts[FEEDBACK_PATTERNS]{};
+    vector<bool> m_isAnswer;
+    vector<RankedGuess> m_ranked;
+};
+
+uint32_t WordleTreeSearch::solve(const vector<uint16_t>& answers, size_t guessesLeft, uint32_t bound, unique_ptr<WordleTreeBuildNode>& outNode) {
+    size_t n = answers.size();
+    if (guessesLeft == 0 || (n > 1 && guessesLeft == 1)) {
+        return TREE_INFEASIBLE;
+    }
+    if (lowerBound(n) >= bound) {
+        return bound;
+    }
+    if (n <= 2) {
+        // guess one, then the other
+        outNode = make_unique<WordleTreeBuildNode>();
+        outNode->guess = answers[0];
+        if (n == 2) {
+            auto leaf = make_unique<WordleTreeBuildNode>();
+            leaf->guess = answers[1];
+            outNode->children.push_back({m_matrix.lookup(answers[0], answers[1]), move(leaf)});
+        }
+        return lowerBound(n);
+    }
+
+    auto guesses = vector<uint16_t>();
+    rankGuesses(answers, TREE_NODE_GUESSES, guesses);
+    uint32_t best = bound;
+    for (auto guess : guesses) {
+        unique_ptr<WordleTreeBuildNode> node;
+        uint32_t cost = solveWithGuess(guess, answers, guessesLeft, best, node);
+        if (cost < best) {
+            best = cost;
+            outNode = move(node);
+            if (best == lowerBound(n)) {
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+uint32_t WordleTreeSearch::solveWithGuess(uint16_t guess, const vector<uint16_t>& answers, size_t guessesLeft, uint32_t bound, unique_ptr<WordleTreeBuildNode>& outNode) {
+    // bucket the answers by the feedback this guess would get
+    const feedback_t* row = m_matrix.getRow(guess);
+    auto tagged = vector<pair<feedback_t, uint16_t>>();
+    tagged.reserve(answers.size());
+    for (auto answer : answers) {
+        tagged.push_back({row[answer], answer});
+    }
+    sort(tagged.begin(), tagged.end());
+
+    auto buckets = vector<pair<feedback_t, vector<uint16_t>>>();
+    for (auto& [feedback, answer] : tagged) {
+        if (feedback == CORRECT_FEEDBACK) {
+            continue;
+        }
+        if (buckets.empty() || buckets.back().first != feedback) {
+            buckets.push_back({feedback, {}});
+        }
+        buckets.back().second.push_back(answer);
+    }
+    if (buckets.size() == 1 && buckets[0].second.size() == answers.size()) {
+        // learns nothing
+        return TREE_INFEASIBLE;
+    }
+
+    uint32_t cost = answers.size();
+    uint32_t remainingBound = 0;
+    for (auto& bucket : buckets) {
+        remainingBound += lowerBound(bucket.second.size());
+    }
+    if (cost + remainingBound >= bound) {
+        return bound;
+    }
+
+    // biggest buckets first, they decide most of the cost and prune the rest sooner
+    stable_sort(buckets.begin(), buckets.end(), [](const auto& a, const auto& b) {
+        return a.second.size() > b.second.size();
+    });
+
+    auto node = make_unique<WordleTreeBuildNode>();
+    node->guess = guess;
+    for (auto& [feedback, bucket] : buckets) {
+        remainingBound -= lowerBound(bucket.size());
+        uint32_t childBound = bound - cost - remainingBound;
+        unique_ptr<WordleTreeBuildNode> child;
+        uint32_t childCost = solve(bucket, guessesLeft - 1, childBound, child);
+        if (childCost >= childBound) {
+            return bound;
+        }
+        cost += childCost;
+        node->children.push_back({feedback, move(child)});
+    }
+
+    sort(node->children.begin(), node->children.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    outNode = move(node);
+    return cost;
+}
+
+void WordleTreeSearch::rankGuesses(const vector<uint16_t>& answers, size_t maxGuesses, vector<uint16_t>& outGuesses) {
+    for (auto answer : answers) {
+        m_isAnswer[answer] = true;
+    }
+
+    // only touched buckets are summed and cleared, most states have few answers
+    feedback_t touched[FEEDBACK_PATTERNS];
+    m_ranked.clear();
+    for (size_t g = 0; g < m_matrix.getNumGuesses(); g++) {
+        const feedback_t* row = m_matrix.getRow(g);
+        size_t numTouched = 0;
+        for (auto answer : answers) {
+            feedback_t feedback = row[answer];
+            if (m_counts[feedback]++ == 0) {
+                touched[numTouched++] = feedback;
+            }
+        }
+        double score = 0;
+        for (size_t i = 0; i < numTouched; i++) {
+            score += m_weightedLogs[m_counts[touched[i]]];
+            m_counts[touched[i]] = 0;
+        }
+        if (numTouched == 1 && touched[0] != CORRECT_FEEDBACK) {
+            continue;
+        }
+        m_ranked.push_back({score, g < m_isAnswer.size() && m_isAnswer[g], static_cast<uint16_t>(g)});
+    }
+
+    size_t shown = min(maxGuesses, m_ranked.size());
+    partial_sort(m_ranked.begin(), m_ranked.begin() + shown, m_ranked.end());
+    outGuesses.clear();
+    bool hasCandidate = false;
+    for (size_t i = 0; i < shown; i++) {
+        outGuesses.push_back(m_ranked[i].guess);
+        hasCandidate = hasCandidate || m_ranked[i].isCandidate;
+    }
+    if (!hasCandidate) {
+        auto bestCandidate = m_ranked.end();
+        for (auto it = m_ranked.begin() + shown; it != m_ranked.end(); it++) {
+            if (it->isCandidate && (bestCandidate == m_ranked.end() || *it < *bestCandidate)) {
+                bestCandidate = it;
+            }
+        }
+        if (bestCandidate != m_ranked.end()) {
+            outGuesses.push_back(bestCandidate->guess);
+        }
+    }
+
+    for (auto answer : answers) {
+        m_isAnswer[answer] = false;
+    }
+}
+
+/////////////////////
+
+WordleDecisionTree::WordleDecisionTree() : m_matrix(WordleFeedbackMatrix::getExtendedMatrix()) {}
+
+const WordleDecisionTree& WordleDecisionTree::getInstance() {
+    static const WordleDecisionTree tree = []() {
+        auto loaded = WordleDecisionTree();
+        if (loaded.load(TREE_FILENAME)) {
+            return loaded;
+        }
+        if (isLogging(WordleLogLevel::INFO)) cerr << "Tree [" << TREE_FILENAME << "] missing or stale, building (save one with --build-tree)" << endl;
+        return build();
+    }();
+    return tree;
+}
+
+WordleDecisionTree WordleDecisionTree::build() {
+    auto tree = WordleDecisionTree();
+    auto& matrix = tree.m_matrix;
+    if (matrix.getNumGuesses() > UINT16_MAX) {
+        cerr << "Error: [tree] too many guesses for 16-bit word IDs" << endl;
+        throw;
+    }
+
+    auto weightedLogs = vector<double>{0};
+    for (size_t n = 1; n <= matrix.getNumAnswers(); n++) {
+        weightedLogs.push_back(n * log2(static_cast<double>(n)));
+    }
+    auto answers = vector<uint16_t>(matrix.getNumAnswers());
+    for (size_t a = 0; a < answers.size(); a++) {
+        answers[a] = a;
+    }
+
+    auto openers = vector<uint16_t>();
+    WordleTreeSearch(matrix, weightedLogs).rankGuesses(answers, TREE_ROOT_GUESSES, openers);
+
+    // one opener per task, sharing the best total so far as the bound
+    auto pool = WordleThreadPool();
+    auto searches = vector<unique_ptr<WordleTreeSearch>>(pool.getNumWorkers());
+    auto roots = vector<unique_ptr<WordleTreeBuildNode>>(openers.size());
+    auto costs = vector<uint32_t>(openers.size(), TREE_INFEASIBLE);
+    atomic<uint32_t> best{TREE_INFEASIBLE};
+    pool.run(openers.size(), 1, [&](size_t workerIdx, size_t begin, size_t end) {
+        auto& search = searches[workerIdx];
+        if (!search) {
+            search = make_unique<WordleTreeSearch>(matrix, weightedLogs);
+        }
+        for (size_t i = begin; i < end; i++) {
+            // +1 keeps openers tied with the best alive, so the winner doesn't depend on timing
+            costs[i] = search->solveWithGuess(openers[i], answers, MAX_GUESSES, best + 1, roots[i]);
+            uint32_t seen = best;
+            while (roots[i] && costs[i] < seen && !best.compare_exchange_weak(seen, costs[i])) {}
+            if (isLogging(WordleLogLevel::VERBOSE)) cout << ("opener " + matrix.getGuess(openers[i]) + ": " + (roots[i] ? to_string(costs[i]) : string("pruned")) + "\n");
+        }
+    });
+
+    size_t bestIdx = openers.size();
+    for (size_t i = 0; i < openers.size(); i++) {
+        if (roots[i] && (bestIdx == openers.size() || costs[i] < costs[bestIdx])) {
+            bestIdx = i;
+        }
+    }
+    if (bestIdx == openers.size()) {
+        cerr << "Error: [tree] no opener solves every answer within " << MAX_GUESSES << " guesses" << endl;
+        throw;
+    }
+
+    // flatten breadth-first, children land contiguous and already sorted by feedback
+    auto order = vector<const WordleTreeBuildNode*>{roots[bestIdx].get()};
+    tree.m_nodes.push_back({roots[bestIdx]->guess, 0, 0, 0});
+    for (size_t i = 0; i < order.size(); i++) {
+        tree.m_nodes[i].firstChild = tree.m_nodes.size();
+        tree.m_nodes[i].numChildren = order[i]->children.size();
+        for (auto& [feedback, child] : order[i]->children) {
+            tree.m_nodes.push_back({child->guess, 0, feedback, 0});
+            order.push_back(child.get());
+        }
+    }
+    tree.m_totalGuesses = costs[bestIdx];
+    return tree;
+}
+
+uint32_t WordleDecisionTree::findChild(uint32_t node, feedback_t feedback) const {
+    auto first = m_nodes.begin() + m_nodes[node].firstChild;
+    auto last = first + m_nodes[node].numChildren;
+    auto it = lower_bound(first, last, feedback, [](const WordleTreeNode& child, feedback_t value) {
+        return child.feedback < value;
+    });
+    if (it == last || it->feedback != feedback) {
+        return NO_NODE;
+    }
+    return it - m_nodes.begin();
+}
+
+bool WordleDecisionTree::save(const string& filename) const {
+    auto header = WordleTreeHeader();
+    memcpy(header.magic, TREE_MAGIC, sizeof(TREE_MAGIC));
+    header.version = TREE_VERSION;
+    header.letterCount = LETTER_COUNT;
+    header.numAnswers = m_matrix.getNumAnswers();
+    header.numGuesses = m_matrix.getNumGuesses();
+    header.wordsHash = m_matrix.getGuessDictionary().hashWords(m_matrix.getNumAnswers());
+    header.numNodes = m_nodes.size();
+    header.totalGuesses = m_totalGuesses;
+
+    auto fileout = ofstream(filename, ios::binary | ios::trunc);
+    fileout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fileout.write(reinterpret_cast<const char*>(m_nodes.data()), m_nodes.size()*sizeof(WordleTreeNode));
+    fileout.close();
+    if (!fileout) {
+        cerr << "Error: [tree] failed to write " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+bool WordleDecisionTree::load(const string& filename) {
+    auto filein = ifstream(filename, ios::binary);
+    auto header = WordleTreeHeader();
+    if (!filein.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, TREE_MAGIC, sizeof(TREE_MAGIC)) != 0 ||
+        header.version != TREE_VERSION ||
+        header.letterCount != LETTER_COUNT ||
+        header.numAnswers != m_matrix.getNumAnswers() ||
+        header.numGuesses != m_matrix.getNumGuesses() ||
+        header.wordsHash != m_matrix.getGuessDictionary().hashWords(m_matrix.getNumAnswers()) ||
+        header.numNodes == 0 || header.numNodes >= NO_NODE) {
+        return false;
+    }
+
+    m_nodes.resize(header.numNodes);
+    if (!filein.read(reinterpret_cast<char*>(m_nodes.data()), m_nodes.size()*sizeof(WordleTreeNode))) {
+        m_nodes.clear();
+        return false;
+    }
+    for (auto& node : m_nodes) {
+        if (node.guess >= header.numGuesses || size_t(node.firstChild) + node.numChildren > m_nodes.size()) {
+            m_nodes.clear();
+            return false;
+        }
+    }
+    m_totalGuesses = header.totalGuesses;
+    if (isLogging(WordleLogLevel::INFO)) cout << "Loaded tree: " << filename << endl;
+    return true;
+}
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+Decision Tree
+
+                         (root) guess: best opener
+                       /    |    ..    \
+   feedback:       BBBBB  BBBBY  ..   GGGGB
+                     |      |           |
+                   guess  guess  ..   guess
+                   / .. \
+                  ...
+
+One node per reachable game state, holding the guess to play there. Children are the
+ states reached by each possible feedback pattern (CORRECT_FEEDBACK ends the game, no child).
+Nodes are stored breadth-first so each node's children are contiguous and sorted by
+ feedback, a lookup is a binary search over at most 242 bytes.
+
+Built offline by `solver --build-tree`, minimizing total guesses over every answer:
+ branch and bound over the best few guesses (by entropy) at each state, never past MAX_GUESSES.
+ */
+struct WordleTreeNode {
+    uint16_t guess;       // guess dictionary word ID
+    feedback_t numChildren; // fewer than FEEDBACK_PATTERNS, so it fits the same width
+    feedback_t feedback;  // pattern leading from the parent into this node
+    uint32_t firstChild;
+};
+
+struct WordleTreeHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t letterCount;
+    uint64_t numAnswers;
+    uint64_t numGuesses;
+    uint64_t wordsHash;    // guess dictionary the word IDs refer to
+    uint64_t numNodes;
+    uint64_t totalGuesses; // summed over every answer
+};
+
+class WordleDecisionTree {
+public:
+    static const uint32_t NO_NODE = UINT32_MAX;
+
+    // Loads TREE_FILENAME, or builds in memory if missing or built for other dictionaries
+    static const WordleDecisionTree& getInstance();
+    // Searches a fresh tree over the extended guess matrix, across all cores
+    static WordleDecisionTree build();
+
+    bool load(const string& filename);
+    bool save(const string& filename) const;
+
+    uint32_t getRoot() const { return 0; }
+    size_t getGuessId(uint32_t node) const { return m_nodes[node].guess; }
+    const string& getGuess(uint32_t node) const { return m_matrix.getGuess(m_nodes[node].guess); }
+    // NO_NODE if `feedback` can't happen from `node`
+    uint32_t findChild(uint32_t node, feedback_t feedback) const;
+    size_t getNumNodes() const { return m_nodes.size(); }
+    double getAverageGuesses() const { return static_cast<double>(m_totalGuesses) / static_cast<double>(m_matrix.getNumAnswers()); }
+private:
+    WordleDecisionTree();
+
+    const WordleFeedbackMatrix& m_matrix;
+    vector<WordleTreeNode> m_nodes;
+    uint64_t m_totalGuesses{0};
+};
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,164 @@
+#include "wordle_dictionary.h"
+#include "wordle_cache.h"
+#include "wordle_rules.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+WordleDictionary::WordleDictionary(const vector<string>& words)
+    : m_positionMasks(LETTER_COUNT*ALPHABET_SIZE), m_letterMasks(LETTER_COUNT*ALPHABET_SIZE) {
+    // first occurrence of each word wins, IDs stay in file order
+    auto sortedInput = vector<pair<uint64_t, uint32_t>>();
+    for (size_t i = 0; i < words.size(); i++) {
+        if (isValidWord(words[i])) {
+            sortedInput.push_back({makeKey(words[i].data()), i});
+        }
+    }
+    sort(sortedInput.begin(), sortedInput.end());
+    auto isKept = vector<bool>(words.size(), false);
+    for (size_t i = 0; i < sortedInput.size(); i++) {
+        if (i == 0 || sortedInput[i].first != sortedInput[i-1].first) {
+            isKept[sortedInput[i].second] = true;
+        }
+    }
+
+    for (size_t i = 0; i < words.size(); i++) {
+        if (isKept[i]) {
+            m_keys.push_back({makeKey(words[i].data()), m_words.size()});
+            m_words.push_back(words[i]);
+            m_ownedLetters.insert(m_ownedLetters.end(), words[i].begin(), words[i].end());
+        }
+    }
+    sort(m_keys.begin(), m_keys.end());
+    m_letters = m_ownedLetters.data();
+    if (m_words.empty() && !words.empty()) {
+        // solver runs the engine matching the answers list, so only a list of another length gets here
+        cerr << "Error: [dictionary] no " << LETTER_COUNT << "-letter words, list starts with [" << words[0] << "], every word list must match " << DICTIONARY_FILENAME << endl;
+        throw length_error("dictionary word length");
+    }
+
+    computeMasks();
+}
+
+WordleDictionary::WordleDictionary(const char* letters, size_t numWords)
+    : m_letters(letters), m_positionMasks(LETTER_COUNT*ALPHABET_SIZE), m_letterMasks(LETTER_COUNT*ALPHABET_SIZE) {
+    for (size_t wordId = 0; wordId < numWords; wordId++) {
+        m_keys.push_back({makeKey(getLetters(wordId)), wordId});
+        m_words.push_back(string(getLetters(wordId), LETTER_COUNT));
+    }
+    sort(m_keys.begin(), m_keys.end());
+
+    computeMasks();
+}
+
+void WordleDictionary::computeMasks() {
+    for (auto& mask : m_positionMasks) {
+        mask.resize(m_words.size(), false);
+    }
+    for (auto& mask : m_letterMasks) {
+        mask.resize(m_words.size(), false);
+    }
+    for (size_t wordId = 0; wordId < m_words.size(); wordId++) {
+        const char* letters = getLetters(wordId);
+        size_t numSeen[ALPHABET_SIZE] = {};
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            size_t letter = letterIndex(letters[i]);
+            m_positionMasks[i*ALPHABET_SIZE + letter].set(wordId);
+            // the nth copy of a letter puts the word in the "at least n" mask
+            m_letterMasks[numSeen[letter]*ALPHABET_SIZE + letter].set(wordId);
+            numSeen[letter]++;
+        }
+    }
+}
+
+const WordleDictionary& WordleDictionary::getAnswers() {
+    auto& cache = WordleCache::getInstance();
+    if (cache.isValid()) {
+        static const WordleDictionary cachedDict(cache.getGuessLetters(), cache.getNumAnswers());
+        return cachedDict;
+    }
+    static const WordleDictionary dict(loadWords(DICTIONARY_FILENAME));
+    return dict;
+}
+
+const WordleDictionary& WordleDictionary::getGuesses() {
+    auto& cache = WordleCache::getInstance();
+    if (cache.isValid()) {
+        static const WordleDictionary cachedDict(cache.getGuessLetters(), cache.getNumGuesses());
+        return cachedDict;
+    }
+    static const WordleDictionary dict([]() {
+        auto words = getAnswers().getWords();
+        auto extended = loadWords(EXTENDED_DICTIONARY_FILENAME);
+        words.insert(words.end(), extended.begin(), extended.end());
+        return words;
+    }());
+    return dict;
+}
+
+bool WordleDictionary::getWordId(string_view word, size_t& outId) const {
+    if (!isValidWord(word)) {
+        return false;
+    }
+
+    uint64_t key = makeKey(word.data());
+    auto it = lower_bound(m_keys.begin(), m_keys.end(), make_pair(key, uint32_t(0)));
+    if (it == m_keys.end() || it->first != key) {
+        return false;
+    }
+    outId = it->second;
+    return true;
+}
+
+uint64_t WordleDictionary::hashWords(uint64_t seed) const {
+    uint64_t hash = 14695981039346656037ull ^ seed;
+    for (size_t i = 0; i < m_words.size()*LETTER_COUNT; i++) {
+        hash = (hash ^ static_cast<uint8_t>(m_letters[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+vector<string> WordleDictionary::loadWords(const string& filename) {
+    // src: https://raw.githubusercontent.com/printfn/wordle-dict/main/answers.txt
+    // src: https://raw.githubusercontent.com/AllValley/WordleDictionary/main/wordle_complete_dictionary.txt
+    auto filein = ifstream(filename);
+    vector<string> words;
+    string word;
+    while (std::getline(filein, word)) {
+        words.push_back(word);
+    }
+
+    if (isLogging(WordleLogLevel::INFO)) cout << "Size of wordlist: " << words.size() << endl;
+    return words;
+}
+
+bool WordleDictionary::isValidWord(string_view word) {
+    if (word.size() != LETTER_COUNT) {
+        return false;
+    }
+    for (auto& c : word) {
+        if (c < 'a' || c > 'z') {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t WordleDictionary::makeKey(const char* letters) {
+    uint64_t key = 0;
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        key = (key << 5) | letterIndex(letters[i]);
+    }
+    return key;
+}
+
+} // namespace WORDLE_NAMESPACE
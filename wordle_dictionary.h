@@ -0,0 +1,71 @@
+#pragma once
+
+#include "wordle_candidates.h"
+#include "wordle_rules.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+ * Immutable word list, loaded once per process and shared by reference.
+ *
+ * Word ID == line order in the source file (duplicates and bad lines dropped).
+ *  m_letters: LETTER_COUNT bytes per word, back to back, no terminators.
+ *             Owned, or pointing straight into the mapped cache file.
+ *  m_keys:    (5 bits per letter, first letter most significant, up to 40 bits) sorted for binary search
+ * Also owns the per-position/per-letter bitset masks the candidate filter uses.
+ */
+class WordleDictionary {
+public:
+    WordleDictionary(const vector<string>& words);
+    // `letters` must outlive the dictionary and hold valid, unique words
+    WordleDictionary(const char* letters, size_t numWords);
+
+    // answers.txt
+    static const WordleDictionary& getAnswers();
+    // answers.txt, then anything else allowed by answers_extended.txt
+    static const WordleDictionary& getGuesses();
+
+    size_t size() const { return m_words.size(); }
+    const char* getLetters(size_t wordId) const { return &m_letters[wordId*LETTER_COUNT]; }
+    const string& getWord(size_t wordId) const { return m_words[wordId]; }
+    const vector<string>& getWords() const { return m_words; }
+
+    /**
+      * true:  word found, ID set
+      * false: word not in dictionary
+      */
+    bool getWordId(string_view word, size_t& outId) const;
+    bool contains(string_view word) const { size_t unused_id; return getWordId(word, unused_id); }
+    // FNV-1a over the packed words, so files keyed by word ID are never read against other lists
+    uint64_t hashWords(uint64_t seed=0) const;
+
+    // words with `letter` at `letterPosition`
+    const WordleBitset& getPositionMask(size_t letterPosition, char letter) const { return m_positionMasks[letterPosition*ALPHABET_SIZE + letterIndex(letter)]; }
+    // words containing `letter` anywhere
+    const WordleBitset& getLetterMask(char letter) const { return getLetterCountMask(letter, 1); }
+    // words containing `letter` at least `minCount` (1..LETTER_COUNT) times
+    const WordleBitset& getLetterCountMask(char letter, size_t minCount) const { return m_letterMasks[(minCount-1)*ALPHABET_SIZE + letterIndex(letter)]; }
+
+    static vector<string> loadWords(const string& filename);
+private:
+    static bool isValidWord(string_view word);
+    static uint64_t makeKey(const char* letters);
+    void computeMasks();
+
+    vector<char> m_ownedLetters;
+    const char* m_letters;
+    vector<string> m_words;
+    vector<pair<uint64_t, uint32_t>> m_keys; // (key, word ID)
+    vector<WordleBitset> m_positionMasks;
+    vector<WordleBitset> m_letterMasks; // [minCount-1][letter]
+};
+
+} // namespace WORDLE_NAMESPACE
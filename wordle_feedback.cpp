@@ -0,0 +1,166 @@
+#include "wordle_feedback.h"
+#include "wordle_cache.h"
+#include "wordle_rules.h"
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+// 3^i for position i
+static const auto FEEDBACK_WEIGHTS = []() {
+    array<feedback_t, LETTER_COUNT> weights{};
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        weights[i] = static_cast<feedback_t>(pow3(i));
+    }
+    return weights;
+}();
+
+feedback_t computeFeedback(const char* guess, const char* answer) {
+    size_t remaining[26] = {0};
+    bool isGreen[LETTER_COUNT] = {false};
+    feedback_t code = 0;
+
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        if (guess[i] == answer[i]) {
+            isGreen[i] = true;
+            code += 2*FEEDBACK_WEIGHTS[i];
+        } else {
+            remaining[answer[i]-'a']++;
+        }
+    }
+
+    // greens take precedence, then yellows left to right while the answer still has that letter
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        if (!isGreen[i] && remaining[guess[i]-'a'] != 0) {
+            remaining[guess[i]-'a']--;
+            code += FEEDBACK_WEIGHTS[i];
+        }
+    }
+
+    return code;
+}
+
+feedback_t encodeFeedback(const WordleResults& results) {
+    feedback_t code = 0;
+    for (size_t i = 0; i < results.size() && i < LETTER_COUNT; i++) {
+        switch (results[i]) {
+        case WordleResult::GREEN:
+            code += 2*FEEDBACK_WEIGHTS[i];
+            break;
+        case WordleResult::YELLOW:
+            code += FEEDBACK_WEIGHTS[i];
+            break;
+        case WordleResult::BLACK:
+            break;
+        }
+    }
+    return code;
+}
+
+WordleResults decodeFeedback(feedback_t code) {
+    auto results = WordleResults();
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        switch (code % 3) {
+        case 2:
+            results.push_back(WordleResult::GREEN);
+            break;
+        case 1:
+            results.push_back(WordleResult::YELLOW);
+            break;
+        default:
+            results.push_back(WordleResult::BLACK);
+            break;
+        }
+        code /= 3;
+    }
+    return results;
+}
+
+/////////////////////
+
+WordleFeedbackMatrix::WordleFeedbackMatrix(const WordleDictionary& answers, const WordleDictionary& guesses)
+    : m_answers(answers), m_guesses(guesses) {
+    checkDictionaries();
+    computeTable();
+    if (isLogging(WordleLogLevel::INFO)) cout << "Size of feedback matrix: " << m_guesses.size() << "x" << m_answers.size() << endl;
+}
+
+WordleFeedbackMatrix::WordleFeedbackMatrix(const WordleDictionary& answers, const WordleDictionary& guesses,
+                                           const feedback_t* table, const double* firstGuessScores)
+    : m_answers(answers), m_guesses(guesses), m_table(table), m_firstGuessScores(firstGuessScores) {
+    checkDictionaries();
+}
+
+void WordleFeedbackMatrix::checkDictionaries() const {
+    if (m_answers.size() == 0) {
+        cerr << "Error: [feedback] empty answer list" << endl;
+        throw;
+    }
+    for (size_t i = 0; i < m_answers.size(); i++) {
+        if (i >= m_guesses.size() || m_guesses.getWord(i) != m_answers.getWord(i)) {
+            cerr << "Error: [feedback] guesses must start with the answers" << endl;
+            throw;
+        }
+    }
+}
+
+const WordleFeedbackMatrix& WordleFeedbackMatrix::getAnswersMatrix() {
+    // cached table rows are answers first, so its top rows are the answers x answers table
+    auto& cache = WordleCache::getInstance();
+    if (cache.getFeedbackTable()) {
+        static const WordleFeedbackMatrix cachedMatrix(WordleDictionary::getAnswers(), WordleDictionary::getAnswers(), cache.getFeedbackTable(), nullptr);
+        return cachedMatrix;
+    }
+    static const WordleFeedbackMatrix matrix(WordleDictionary::getAnswers(), WordleDictionary::getAnswers());
+    return matrix;
+}
+
+const WordleFeedbackMatrix& WordleFeedbackMatrix::getExtendedMatrix() {
+    auto& cache = WordleCache::getInstance();
+    if (cache.getFeedbackTable()) {
+        static const WordleFeedbackMatrix cachedMatrix(WordleDictionary::getAnswers(), WordleDictionary::getGuesses(), cache.getFeedbackTable(), cache.getFirstGuessScores());
+        return cachedMatrix;
+    }
+    static const WordleFeedbackMatrix matrix(WordleDictionary::getAnswers(), WordleDictionary::getGuesses());
+    return matrix;
+}
+
+void WordleFeedbackMatrix::computeHistogram(size_t guessIdx, const vector<size_t>& answerIdxs, uint32_t counts[FEEDBACK_PATTERNS]) const {
+    // 4 interleaved sub-histograms so back-to-back hits on the same bucket don't serialize
+    uint32_t sub[4][FEEDBACK_PATTERNS] = {};
+    const feedback_t* row = getRow(guessIdx);
+    const size_t n = answerIdxs.size();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        sub[0][row[answerIdxs[i]]]++;
+        sub[1][row[answerIdxs[i+1]]]++;
+        sub[2][row[answerIdxs[i+2]]]++;
+        sub[3][row[answerIdxs[i+3]]]++;
+    }
+    for (; i < n; i++) {
+        sub[0][row[answerIdxs[i]]]++;
+    }
+
+    for (size_t p = 0; p < FEEDBACK_PATTERNS; p++) {
+        counts[p] = sub[0][p] + sub[1][p] + sub[2][p] + sub[3][p];
+    }
+}
+
+void WordleFeedbackMatrix::computeTable() {
+    m_ownedTable.resize(m_guesses.size() * m_answers.size());
+    m_table = m_ownedTable.data();
+    for (size_t g = 0; g < m_guesses.size(); g++) {
+        feedback_t* row = &m_ownedTable[g*m_answers.size()];
+        for (size_t a = 0; a < m_answers.size(); a++) {
+            row[a] = computeFeedback(m_guesses.getLetters(g), m_answers.getLetters(a));
+        }
+    }
+}
+
+} // namespace WORDLE_NAMESPACE
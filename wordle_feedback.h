@@ -0,0 +1,91 @@
+#pragma once
+
+#include "wordle_dictionary.h"
+#include "wordle_rules.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+/**
+ * Feedback for one guess packed as a base-3 number, one digit per letter position:
+ *   BLACK=0, YELLOW=1, GREEN=2, position i weighted by 3^i
+ * 5 letters -> 3^5 = 243 patterns (0..242), all greens == CORRECT_FEEDBACK
+ * Up to 5 letters fit a byte, 6-8 letters (729..6561 patterns) take two.
+ */
+constexpr size_t pow3(size_t exponent) { return exponent == 0 ? 1 : 3 * pow3(exponent - 1); }
+
+static const size_t FEEDBACK_PATTERNS = pow3(LETTER_COUNT);
+using feedback_t = conditional_t<(FEEDBACK_PATTERNS <= 256), uint8_t, uint16_t>;
+static const feedback_t CORRECT_FEEDBACK = FEEDBACK_PATTERNS - 1;
+
+feedback_t computeFeedback(const char* guess, const char* answer);
+inline feedback_t computeFeedback(const string& guess, const string& answer) { return computeFeedback(guess.data(), answer.data()); }
+feedback_t encodeFeedback(const WordleResults& results);
+WordleResults decodeFeedback(feedback_t code);
+
+/**
+Feedback Matrix
+
+                answer[0]  answer[1]  ..  answer[M-1]
+   guess[0]       242         0             17
+   guess[1]        9        242              0
+   ...
+   guess[N-1]     ...
+
+Dense N x M table of `feedback_t`, computed once per process.
+Rows/columns are `WordleDictionary` word IDs. Guess dictionaries list the answers first,
+ so the answers x answers table is the top rows of the extended guesses x answers table
+ and guess index == answer index for every answer word.
+ */
+class WordleFeedbackMatrix {
+public:
+    WordleFeedbackMatrix(const WordleDictionary& answers, const WordleDictionary& guesses);
+    // Precomputed table/scores (e.g. from the mapped cache), must outlive the matrix
+    WordleFeedbackMatrix(const WordleDictionary& answers, const WordleDictionary& guesses,
+                         const feedback_t* table, const double* firstGuessScores);
+
+    // answers.txt x answers.txt
+    static const WordleFeedbackMatrix& getAnswersMatrix();
+    // answers_extended.txt x answers.txt
+    static const WordleFeedbackMatrix& getExtendedMatrix();
+
+    feedback_t lookup(size_t guessIdx, size_t answerIdx) const { return m_table[guessIdx*m_answers.size() + answerIdx]; }
+    const feedback_t* getRow(size_t guessIdx) const { return &m_table[guessIdx*m_answers.size()]; }
+
+    // counts[p] = number of answers in `answerIdxs` that `guessIdx` splits into pattern p
+    void computeHistogram(size_t guessIdx, const vector<size_t>& answerIdxs, uint32_t counts[FEEDBACK_PATTERNS]) const;
+
+    /**
+      * true:  word found, index set
+      * false: word not in guess/answer list
+      */
+    bool getGuessIndex(string_view word, size_t& outIdx) const { return m_guesses.getWordId(word, outIdx); }
+    bool getAnswerIndex(string_view word, size_t& outIdx) const { return m_answers.getWordId(word, outIdx); }
+
+    const string& getGuess(size_t guessIdx) const { return m_guesses.getWord(guessIdx); }
+    const string& getAnswer(size_t answerIdx) const { return m_answers.getWord(answerIdx); }
+    size_t getNumGuesses() const { return m_guesses.size(); }
+    size_t getNumAnswers() const { return m_answers.size(); }
+    const WordleDictionary& getGuessDictionary() const { return m_guesses; }
+    const WordleDictionary& getAnswerDictionary() const { return m_answers; }
+    // sum_p c_p*log2(c_p) of each guess over every answer, nullptr unless loaded from cache
+    const double* getFirstGuessScores() const { return m_firstGuessScores; }
+private:
+    void checkDictionaries() const;
+    void computeTable();
+
+    const WordleDictionary& m_answers;
+    const WordleDictionary& m_guesses;
+    vector<feedback_t> m_ownedTable;
+    const feedback_t* m_table;
+    const double* m_firstGuessScores{nullptr};
+};
+
+} // namespace WORDLE_NAMESPACE
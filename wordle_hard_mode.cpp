@@ -0,0 +1,35 @@
+#include "wordle_hard_mode.h"
+#include "wordle_rules.h"
+
+#include <bit>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+WordleHardMode::WordleHardMode(const WordleDictionary& guesses) : m_guesses(guesses), m_allowed(guesses.size(), true) {}
+
+void WordleHardMode::reset() {
+    m_rules.reset();
+    m_allowed.resize(m_guesses.size(), true);
+}
+
+void WordleHardMode::addResult(const WordleConstraint& constraint) {
+    m_rules.addResult(constraint);
+
+    // earlier results are already in m_allowed, only this one's hints need ANDing in
+    WordleFixedVector<const WordleBitset*, 2*LETTER_COUNT> keep;
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        if (constraint.isGreen(i)) {
+            keep.push_back(&m_guesses.getPositionMask(i, m_rules.greens[i]));
+        }
+    }
+    for (uint32_t rest = constraint.presentLetters; rest != 0; rest &= rest - 1) {
+        size_t letter = countr_zero(rest);
+        keep.push_back(&m_guesses.getLetterCountMask(static_cast<char>('a' + letter), constraint.minCount[letter]));
+    }
+    m_allowed.filter(keep.begin(), keep.size(), nullptr, 0);
+}
+
+} // namespace WORDLE_NAMESPACE
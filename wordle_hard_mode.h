@@ -0,0 +1,79 @@
+#pragma once
+
+#include "wordle_candidates.h"
+#include "wordle_constraint.h"
+#include "wordle_dictionary.h"
+#include "wordle_rules.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+ * Hard mode: every guess must reuse the hints revealed so far
+ *   greens[i]:   letter that must stay at position i, 0 if none yet
+ *   minCount[c]: copies of c the guess must hold, the most ever revealed (green or yellow) in one guess
+ * Same rule as the official game: yellows may move, black letters may be played again.
+ */
+struct WordleHardRules {
+    void reset() { *this = WordleHardRules(); }
+    void addResult(const WordleConstraint& constraint) {
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            if (constraint.isGreen(i)) {
+                greens[i] = static_cast<char>('a' + countr_zero(constraint.allowed[i]));
+            }
+        }
+        for (size_t letter = 0; letter < ALPHABET_SIZE; letter++) {
+            minCount[letter] = max(minCount[letter], constraint.minCount[letter]);
+        }
+    }
+    bool allows(const char* letters) const {
+        uint8_t numOccurs[ALPHABET_SIZE] = {};
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            if (greens[i] && letters[i] != greens[i]) {
+                return false;
+            }
+            numOccurs[letterIndex(letters[i])]++;
+        }
+        for (size_t letter = 0; letter < ALPHABET_SIZE; letter++) {
+            if (numOccurs[letter] < minCount[letter]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    char greens[LETTER_COUNT]{};
+    uint8_t minCount[ALPHABET_SIZE]{};
+};
+
+/**
+ * Guesses still allowed in hard mode, as a bitset over the guess dictionary.
+ * Each result narrows it with the dictionary's precomputed masks in one pass:
+ *   getPositionMask(i, letter):          a green at i
+ *   getLetterCountMask(letter, n):       n revealed copies of letter
+ * Guess dictionaries list the answers first, so an answer's ID works here too.
+ */
+class WordleHardMode {
+public:
+    WordleHardMode(const WordleDictionary& guesses);
+
+    // every guess allowed again, reusing the storage
+    void reset();
+    void addResult(const WordleConstraint& constraint);
+    const WordleHardRules& getRules() const { return m_rules; }
+    const WordleBitset& getAllowed() const { return m_allowed; }
+    bool isAllowed(size_t wordId) const { return m_allowed.test(wordId); }
+    size_t getNumAllowed() const { return m_allowed.count(); }
+private:
+    const WordleDictionary& m_guesses;
+    WordleHardRules m_rules;
+    WordleBitset m_allowed;
+};
+
+} // namespace WORDLE_NAMESPACE
@@ -1,37 +1,72 @@
 #pragma once
 
+#include "wordle_dictionary.h"
 #include "wordle_rules.h"
+#include "wordle_selector.h"
 #include "wordle_solver.h"
 #include "wordlist_wordle_solver.h"
 
 #include <algorithm>
 #include <ctype.h>
-#include <fstream>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
 
+namespace WORDLE_NAMESPACE {
 
-inline size_t countOccurs(char letter, const string& word) {
+
+inline size_t countOccurs(char letter, string_view word) {
     return std::count(word.begin(), word.end(), letter);
 }
 
 class Helpers {
 public:
-    static unique_ptr<WordleSolverImpl> createWordleSolver(const string& solverType) {
+    static unique_ptr<WordleSolverImpl> createWordleSolver(const string& solverType, const string& selectorType="", bool isHardMode=false) {
+        WordleSelectorType selector = WordleSelectorType::FrequencyAndPositionalLetter;
+        if (selectorType.size() > 0 && !getSelectorType(selectorType, selector)) {
+            cerr << "Error: [helpers] invalid selector" << endl;
+            throw;
+        }
+
         unique_ptr<WordleSolverImpl> solverPtr;
         if (solverType == "trie") {
-            solverPtr = make_unique<TrieBasedWordleSolver>();
+            solverPtr = make_unique<TrieBasedWordleSolver>(selector);
         } else if (solverType == "wordlist") {
-            solverPtr = make_unique<WordlistWordleSolver>();
+            solverPtr = make_unique<WordlistWordleSolver>(selector);
+        } else if (solverType == "tree") {
+            // selector only plays once off the tree
+            solverPtr = make_unique<DecisionTreeWordleSolver>(selectorType.size() > 0 ? selector : WordleSelectorType::Entropy);
         // } else {
         //     printUsage();
         }
+        if (solverPtr) {
+            solverPtr->setHardMode(isHardMode);
+        }
         return solverPtr;
     }
 
+    static bool getSelectorType(const string& selectorType, WordleSelectorType& outType) {
+        static const unordered_map<string, WordleSelectorType> selectors = {
+            {"Random", WordleSelectorType::Random},
+            {"EnhancedRandom", WordleSelectorType::EnhancedRandom},
+            {"NaiveMostCommonLetter", WordleSelectorType::NaiveMostCommonLetter},
+            {"ImprovedMostCommonLetter", WordleSelectorType::ImprovedMostCommonLetter},
+            {"PositionalLetter", WordleSelectorType::PositionalLetter},
+            {"FrequencyAndPositionalLetter", WordleSelectorType::FrequencyAndPositionalLetter},
+            {"Entropy", WordleSelectorType::Entropy},
+            {"Minimax", WordleSelectorType::Minimax},
+        };
+        auto it = selectors.find(selectorType);
+        if (it == selectors.end()) {
+            return false;
+        }
+        outType = it->second;
+        return true;
+    }
+
     static WordleGuess promptUserToCheckGuess(const string& output, size_t guessNumber) {
         cout << "Guess #" << guessNumber << ": " << output << endl;
 
@@ -77,12 +112,8 @@ public:
         return input;
     }
 
-    static vector<string> getDictionary(const string& filename=DICTIONARY_FILENAME) {
-        auto filein = ifstream(filename);
-        vector<string> words;
-        string word;
-        while (std::getline(filein, word)) { words.push_back(word); }
-        return words;
+    static const vector<string>& getDictionary() {
+        return WordleDictionary::getAnswers().getWords();
     }
 
     static bool isWordInDictionary(const string& word, const vector<string>& dict) {
@@ -90,11 +121,11 @@ public:
     }
 
     static bool isWordInDictionary(const string& word) {
-        return isWordInDictionary(word, getDictionary());
+        return WordleDictionary::getAnswers().contains(word);
     }
 private:
     static WordleGuess stringToWordleGuess(const string& guess, const string& str) {
-        vector<WordleResult> wr;
+        WordleResults wr;
 
         for (auto& s : str) {
             switch(tolower(s)) {
@@ -108,9 +139,7 @@ private:
                 wr.push_back(WordleResult::BLACK);
                 break;
             default:
-                if (DEBUG) {
-                    cerr << "Error: [helpers] invalid wordle answer" << endl;
-                }
+                cerr << "Error: [helpers] invalid wordle answer" << endl;
                 throw;
             }
         }
@@ -167,3 +196,5 @@ private:
         }
     }
 };
+
+} // namespace WORDLE_NAMESPACE
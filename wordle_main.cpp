@@ -0,0 +1,199 @@
+#include "wordle_main.h"
+#include "game_modes.h"
+#include "wordle_buffer.h"
+#include "wordle_cache.h"
+#include "wordle_checker.h"
+#include "wordle_decision_tree.h"
+#include "wordle_helpers.h"
+#include "wordle_rules.h"
+#include "wordle_selector.h"
+#include "wordle_solver.h"
+#include "wordlist_wordle_solver.h"
+
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+
+#include <boost/program_options.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+namespace WORDLE_NAMESPACE {
+
+
+void printUsage() {
+    cerr << "Usage: solver [-h/--help] --mode mode [-t/--multi] [--hard] [-q/--quiet|-v/--verbose|--trace] --word word" << endl << endl;
+    cerr << "Options:" << endl;
+    cerr << " -h,--help   : produce help message" << endl;
+    cerr << " -s,--solver : choose between: trie(default),wordlist,tree" << endl;
+    cerr << " -l,--selector : choose between: EnhancedRandom,Entropy,FrequencyAndPositionalLetter(default),ImprovedMostCommonLetter,Minimax,NaiveMostCommonLetter,PositionalLetter,Random" << endl;
+    cerr << " -m,--mode   : choose between: all,batch,cheat,debug,interactive,multi,one,openers" << endl;
+    cerr << " -t,--multi  : multi-threaded (assumes --mode all)" << endl;
+    cerr << " -w,--word   : answer word for certain modes" << endl;
+    cerr << " --hard      : hard mode, every guess must reuse the hints revealed so far" << endl;
+    cerr << " -q,--quiet  : only rows, summaries and errors" << endl;
+    cerr << " -v,--verbose: also every guess's feedback and candidate counts (default for one,debug)" << endl;
+    cerr << " --trace     : also ranked guesses and candidate lists (default for cheat,interactive)" << endl;
+    cerr << " -i,--input  : answers for '--mode batch', one per line, '-' for stdin (default)" << endl;
+    cerr << " -o,--output : CSV rows from '--mode batch', '-' for stdout (default)" << endl;
+    cerr << " --boards    : boards per game for '--mode multi' (default 4)" << endl;
+    cerr << " --games     : random answer tuples played by '--mode multi' (default 1000)" << endl;
+    cerr << " --seed      : seed for the answer tuples (default 0)" << endl;
+    cerr << " --top       : best openers by entropy swept by '--mode openers' (default 10), the best is written to " << OPENERS_FILENAME << endl;
+    cerr << " --build-cache : write " << CACHE_FILENAME << " from the text dictionaries and exit" << endl;
+    cerr << " --build-tree  : search the decision tree for '--solver tree', write " << TREE_FILENAME << " and exit" << endl;
+    exit(1);
+}
+
+int runMain(int argc, char* argv[]) {
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("solver,s", po::value<string>(), "choose between: trie(default),wordlist,tree")
+        ("selector,l", po::value<string>(), "EnhancedRandom,Entropy,FrequencyAndPositionalLetter(default),ImprovedMostCommonLetter,Minimax,NaiveMostCommonLetter,PositionalLetter,Random")
+        ("mode,m", po::value<string>(), "choose between: all,batch,cheat,debug,interactive,multi,one,openers")
+        ("multi,t", "multi-threaded (assumes --mode all)")
+        ("word,w", po::value<string>(), "answer word for certain modes")
+        ("hard", "hard mode, every guess must reuse the hints revealed so far")
+        ("quiet,q", "only rows, summaries and errors")
+        ("verbose,v", "also every guess's feedback and candidate counts")
+        ("trace", "also ranked guesses and candidate lists")
+        ("input,i", po::value<string>()->default_value("-"), "answers for '--mode batch', one per line, '-' for stdin")
+        ("output,o", po::value<string>()->default_value("-"), "CSV rows from '--mode batch', '-' for stdout")
+        ("boards", po::value<size_t>()->default_value(4), "boards per game for '--mode multi'")
+        ("games", po::value<size_t>()->default_value(1000), "random answer tuples played by '--mode multi'")
+        ("seed", po::value<size_t>()->default_value(0), "seed for the answer tuples")
+        ("top", po::value<size_t>()->default_value(10), "best openers by entropy swept by '--mode openers'")
+        ("build-cache", "write the binary dictionary/feedback cache and exit")
+        ("build-tree", "write the decision tree for '--solver tree' and exit")
+        ;
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(/*argc=*/argc, /*argv=*/argv, /*options_desc=*/desc), vm);
+    } catch (const std::exception& e) {
+        cout << "Exception Error: " << e.what() << endl;
+        return 3;
+    }
+
+    po::notify(vm);
+    if (vm.count("help")) {
+        printUsage();
+    }
+
+    // single games show their work unless told otherwise, sweeps stay terse
+    string modeName = vm.count("mode") ? vm["mode"].as<string>() : "";
+    if (vm.count("trace")) {
+        g_log_level = WordleLogLevel::TRACE;
+    } else if (vm.count("verbose")) {
+        g_log_level = WordleLogLevel::VERBOSE;
+    } else if (vm.count("quiet")) {
+        g_log_level = WordleLogLevel::QUIET;
+    } else if (modeName == "cheat" || modeName == "interactive") {
+        g_log_level = WordleLogLevel::TRACE;
+    } else if (modeName == "one" || modeName == "debug") {
+        g_log_level = WordleLogLevel::VERBOSE;
+    }
+
+    if (vm.count("build-cache")) {
+        return WordleCache::build() ? 0 : 1;
+    }
+
+    if (vm.count("build-tree")) {
+        auto tree = WordleDecisionTree::build();
+        if (!tree.save(TREE_FILENAME)) {
+            return 1;
+        }
+        cout << "Wrote tree: " << TREE_FILENAME << " (" << tree.getNumNodes() << " nodes, average guesses: " << tree.getAverageGuesses() << ")" << endl;
+        return 0;
+    }
+
+    string selectorType;
+    if (vm.count("selector")) {
+        selectorType = vm["selector"].as<string>();
+        WordleSelectorType unused_type;
+        if (!Helpers::getSelectorType(selectorType, unused_type)) {
+            cerr << "selector [" << selectorType << "] not recognized" << endl;
+            printUsage();
+        }
+    }
+
+    if (vm.count("mode")) {
+        auto solverMode = vm["mode"].as<string>();
+        // batch rows may go to stdout, keep everything else off it
+        ostream& log = (solverMode == "batch") ? cerr : cout;
+        if (isLogging(WordleLogLevel::INFO)) log << "Wordle Solver v" << VERSION << endl;
+        string solverType = "trie";
+        if (vm.count("solver")) {
+            solverType = vm["solver"].as<string>();
+        }
+        bool isHardMode = vm.count("hard") > 0;
+        auto solver = Helpers::createWordleSolver(solverType, selectorType, isHardMode);
+        if (isLogging(WordleLogLevel::INFO)) log << "mode:" << solverMode << (isHardMode ? " (hard)" : "") << endl;
+
+        if (solverMode == "all") {
+            if (vm.count("multi")) {
+                if (isLogging(WordleLogLevel::INFO)) cout << "multi-threaded" << endl << endl;
+                runAllWordsMultiThreaded(solverType, selectorType, isHardMode);
+            } else {
+                if (isLogging(WordleLogLevel::INFO)) cout << endl;
+                runAllWords(solverType, selectorType, isHardMode);
+            }
+        } else if (solverMode == "batch") {
+            if (runBatch(solverType, selectorType, isHardMode, vm["input"].as<string>(), vm["output"].as<string>()) != 0) {
+                return 1;
+            }
+        } else if (solverMode == "multi") {
+            size_t numBoards = vm["boards"].as<size_t>();
+            if (isLogging(WordleLogLevel::INFO)) cout << numBoards << " boards" << (vm.count("multi") ? ", multi-threaded" : "") << endl << endl;
+            runMultiBoardSweep(numBoards, vm["games"].as<size_t>(), vm["seed"].as<size_t>(), vm.count("multi") > 0);
+        } else if (solverMode == "openers") {
+            if (runOpeners(selectorType, vm["top"].as<size_t>()) != 0) {
+                return 1;
+            }
+        } else if (solverMode == "one") {
+            if (!vm.count("word")) {
+                cerr << "'one' mode requires a 'word' as a solution" << endl;
+                printUsage();
+            }
+            if (!Helpers::isWordInDictionary(vm["word"].as<string>())) {
+                cerr << "Error: [" << vm["word"].as<string>() << "] not in the wordlist" << endl;
+                return 1;
+            }
+            cout << endl;
+            auto wb = make_shared<WordleBuffer>();
+            wb->write("guess1cands,guess2cands,guess3cands,guess4cands,guess5cands,guess6cands,result,words_left,num_guesses,answer", 0, /*newline=*/ true);
+            runOneGame(solverType, selectorType, vm["word"].as<string>(), 1, wb, nullptr, isHardMode);
+        } else if (solverMode == "cheat") {
+            cout << endl;
+            cheatMode(move(solver));
+        } else if (solverMode == "debug") {
+            if (!vm.count("word")) {
+                cerr << "'debug' mode requires a 'word' as a solution" << endl;
+                printUsage();
+            }
+            if (!Helpers::isWordInDictionary(vm["word"].as<string>())) {
+                cerr << "Error: [" << vm["word"].as<string>() << "] not in the wordlist" << endl;
+                return 1;
+            }
+            cout << endl;
+            runDebug(move(solver), vm["word"].as<string>());
+        } else if (solverMode == "interactive") {
+            cout << endl;
+            interactiveMode(move(solver));
+        } else {
+            cerr << "mode [" << solverMode << "] not recognized" << endl;
+            printUsage();
+        }
+    } else {
+        printUsage();
+    }
+
+    return 0;
+}
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "wordle_rules.h"
+
+namespace WORDLE_NAMESPACE {
+
+
+// solver's command line for this word length: parses the options, runs the mode and returns the exit code
+int runMain(int argc, char* argv[]);
+
+} // namespace WORDLE_NAMESPACE
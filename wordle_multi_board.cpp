@@ -0,0 +1,162 @@
+#include "wordle_multi_board.h"
+#include "wordle_constraint.h"
+#include "wordle_dictionary.h"
+#include "wordle_rules.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+WordleMultiBoardSolver::WordleMultiBoardSolver(size_t numBoards) : m_matrix(WordleFeedbackMatrix::getExtendedMatrix()) {
+    if (numBoards == 0 || numBoards > MAX_BOARDS) {
+        cerr << "Error: [multi] boards must be 1 to " << MAX_BOARDS << endl;
+        throw;
+    }
+
+    m_boards.resize(numBoards);
+    for (auto& board : m_boards) {
+        board.filter = make_unique<WordleCandidateFilter>(m_matrix.getAnswerDictionary());
+        board.answerIdxs.reserve(m_matrix.getNumAnswers());
+    }
+    m_unsolved.reserve(numBoards);
+    m_patternCounts.assign(FEEDBACK_PATTERNS, 0);
+    m_weightedLogs.push_back(0);
+    for (size_t n = 1; n <= m_matrix.getNumAnswers(); n++) {
+        m_weightedLogs.push_back(n * log2(static_cast<double>(n)));
+    }
+}
+
+void WordleMultiBoardSolver::reset() {
+    for (auto& board : m_boards) {
+        board.filter->reset();
+        board.isSolved = false;
+    }
+    m_isFirstGuess = true;
+}
+
+string WordleMultiBoardSolver::makeGuess() {
+    // every board starts from the same answers, so the best opener for one is best for all
+    if (m_isFirstGuess) {
+        m_isFirstGuess = false;
+        return m_matrix.getGuess(getOpener());
+    }
+
+    m_unsolved.clear();
+    for (auto& board : m_boards) {
+        if (board.isSolved) {
+            continue;
+        }
+        board.answerIdxs.clear();
+        auto& candidates = board.filter->getCandidates();
+        for (auto it = candidates.begin(); it != candidates.end(); it++) {
+            board.answerIdxs.push_back(it.getWordId());
+        }
+        if (board.answerIdxs.size() == 1) {
+            return m_matrix.getAnswer(board.answerIdxs[0]);
+        }
+        m_unsolved.push_back(&board);
+    }
+
+    if (m_unsolved.empty()) {
+        cerr << "Error: [multi] every board already solved" << endl;
+        throw;
+    }
+
+    // tie: prefer a guess that could solve one of the boards
+    size_t best = m_unsolved[0]->answerIdxs[0];
+    double bestEntropy = getCombinedEntropy(best, m_unsolved);
+    for (size_t g = 0; g < m_matrix.getNumGuesses(); g++) {
+        double entropy = getCombinedEntropy(g, m_unsolved);
+        if (entropy > bestEntropy || (entropy == bestEntropy && isCandidate(g, m_unsolved) && !isCandidate(best, m_unsolved))) {
+            best = g;
+            bestEntropy = entropy;
+        }
+    }
+    return m_matrix.getGuess(best);
+}
+
+void WordleMultiBoardSolver::processResult(size_t board, const WordleGuess& guess) {
+    if (guess == CorrectWordleGuess) {
+        m_boards[board].isSolved = true;
+        return;
+    }
+    m_boards[board].filter->applyConstraint(WordleConstraint(guess));
+}
+
+size_t WordleMultiBoardSolver::getOpener() {
+    if (m_hasOpener) {
+        return m_opener;
+    }
+
+    // lowest sum_p c_p*log2(c_p) over every answer, from the cache when it has the scores
+    auto& allAnswers = m_boards[0].answerIdxs;
+    allAnswers.clear();
+    for (size_t a = 0; a < m_matrix.getNumAnswers(); a++) {
+        allAnswers.push_back(a);
+    }
+    uint32_t counts[FEEDBACK_PATTERNS];
+    double bestScore = 0;
+    for (size_t g = 0; g < m_matrix.getNumGuesses(); g++) {
+        double score = 0;
+        if (m_matrix.getFirstGuessScores()) {
+            score = m_matrix.getFirstGuessScores()[g];
+        } else {
+            m_matrix.computeHistogram(g, allAnswers, counts);
+            for (size_t p = 0; p < FEEDBACK_PATTERNS; p++) {
+                score += m_weightedLogs[counts[p]];
+            }
+        }
+        if (g == 0 || score < bestScore) {
+            m_opener = g;
+            bestScore = score;
+        }
+    }
+    m_hasOpener = true;
+    return m_opener;
+}
+
+double WordleMultiBoardSolver::getCombinedEntropy(size_t guessIdx, const vector<Board*>& unsolved) {
+    // boards are small after the opener, so only the patterns that turn up are visited and cleared
+    auto& counts = m_patternCounts;
+    feedback_t touched[FEEDBACK_PATTERNS];
+    const feedback_t* row = m_matrix.getRow(guessIdx);
+    double entropy = 0;
+    for (auto* board : unsolved) {
+        size_t numTouched = 0;
+        for (auto answerIdx : board->answerIdxs) {
+            feedback_t feedback = row[answerIdx];
+            if (counts[feedback]++ == 0) {
+                touched[numTouched++] = feedback;
+            }
+        }
+        double score = 0;
+        for (size_t t = 0; t < numTouched; t++) {
+            score += m_weightedLogs[counts[touched[t]]];
+            counts[touched[t]] = 0;
+        }
+        double n = static_cast<double>(board->answerIdxs.size());
+        entropy += log2(n) - score / n;
+    }
+    return entropy;
+}
+
+bool WordleMultiBoardSolver::isCandidate(size_t guessIdx, const vector<Board*>& unsolved) const {
+    // answers come first in the guess list, so a guess index below getNumAnswers() is an answer index
+    if (guessIdx >= m_matrix.getNumAnswers()) {
+        return false;
+    }
+    for (auto* board : unsolved) {
+        if (board->filter->getCandidates().contains(guessIdx)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace WORDLE_NAMESPACE
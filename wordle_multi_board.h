@@ -0,0 +1,60 @@
+#pragma once
+
+#include "wordle_candidate_filter.h"
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+ * Several boards played at once (Quordle: 4, Octordle: 8), every guess goes to each unsolved board.
+ *
+ * Each board keeps its own candidates in a `WordleCandidateFilter`, narrowed by the guess's constraint.
+ * Guesses come from the extended feedback matrix, picked by entropy summed over the unsolved boards:
+ *   H(g) = sum_b [log2(n_b) - (1/n_b) * sum_p c_bp*log2(c_bp)], c_bp = #candidates on b giving pattern p
+ * A board down to one candidate is played straight away, it can't be solved any sooner.
+ * One solver per thread, games run in parallel across solvers.
+ */
+class WordleMultiBoardSolver {
+public:
+    WordleMultiBoardSolver(size_t numBoards);
+
+    // Every board back to all answers, keeps the scored opener
+    void reset();
+    string makeGuess();
+    // `guess` as checked against `board`'s answer, narrows that board only
+    void processResult(size_t board, const WordleGuess& guess);
+
+    size_t getNumBoards() const { return m_boards.size(); }
+    size_t getMaxGuesses() const { return m_boards.size() + MULTI_BOARD_EXTRA_GUESSES; }
+    bool isSolved(size_t board) const { return m_boards[board].isSolved; }
+    size_t getNumCandidates(size_t board) const { return m_boards[board].filter->getNumCandidates(); }
+private:
+    struct Board {
+        unique_ptr<WordleCandidateFilter> filter;
+        vector<size_t> answerIdxs; // scoring scratch, the candidates as answer indices
+        bool isSolved{false};
+    };
+
+    size_t getOpener();
+    double getCombinedEntropy(size_t guessIdx, const vector<Board*>& unsolved);
+    bool isCandidate(size_t guessIdx, const vector<Board*>& unsolved) const;
+
+    const WordleFeedbackMatrix& m_matrix;
+    vector<Board> m_boards;
+    vector<Board*> m_unsolved;     // makeGuess() scratch
+    vector<double> m_weightedLogs; // n*log2(n)
+    vector<uint32_t> m_patternCounts; // getCombinedEntropy() scratch, all 0 between calls
+    size_t m_opener;
+    bool m_hasOpener{false};
+    bool m_isFirstGuess{true};
+};
+
+} // namespace WORDLE_NAMESPACE
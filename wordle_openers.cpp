@@ -0,0 +1,198 @@
+#include "wordle_openers.h"
+#include "wordle_dictionary.h"
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+#include "wordle_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+static const char OPENERS_MAGIC[8] = {'W', 'O', 'R', 'D', 'L', 'E', 'O', '1'};
+static const uint32_t OPENERS_VERSION = 1;
+
+WordleOpeners::WordleOpeners() : m_answers(WordleDictionary::getAnswers()), m_guesses(WordleDictionary::getGuesses()) {}
+
+const WordleOpeners& WordleOpeners::getInstance() {
+    static const WordleOpeners openers = []() {
+        // nothing to fall back on but the solver's own opener, the search takes a while
+        auto loaded = WordleOpeners();
+        loaded.load(OPENERS_FILENAME);
+        return loaded;
+    }();
+    return openers;
+}
+
+WordleOpeners WordleOpeners::score(WordleSelectorType selectorType) {
+    auto openers = WordleOpeners();
+    auto& matrix = WordleFeedbackMatrix::getExtendedMatrix();
+    if (matrix.getNumGuesses() > UINT16_MAX || matrix.getNumAnswers() > UINT16_MAX) {
+        cerr << "Error: [openers] too many words for 16-bit word IDs" << endl;
+        throw;
+    }
+    openers.m_selectorType = selectorType;
+
+    auto answers = vector<size_t>(matrix.getNumAnswers());
+    for (size_t a = 0; a < answers.size(); a++) {
+        answers[a] = a;
+    }
+    double n = static_cast<double>(answers.size());
+
+    auto& scores = openers.m_scores;
+    scores.resize(matrix.getNumGuesses());
+    auto pool = WordleThreadPool();
+    size_t chunkSize = scores.size() / (pool.getNumWorkers() * 8) + 1;
+    atomic<size_t> numScored{0};
+    pool.run(scores.size(), chunkSize, [&](size_t workerIdx, size_t begin, size_t end) {
+        uint32_t counts[FEEDBACK_PATTERNS];
+        for (size_t g = begin; g < end; g++) {
+            matrix.computeHistogram(g, answers, counts);
+            double sumSquares = 0;
+            double weightedLogs = 0;
+            uint32_t worstCase = 0;
+            for (size_t p = 0; p < FEEDBACK_PATTERNS; p++) {
+                if (counts[p] == 0) {
+                    continue;
+                }
+                double c = static_cast<double>(counts[p]);
+                sumSquares += c * c;
+                weightedLogs += c * log2(c);
+                worstCase = max(worstCase, counts[p]);
+            }
+            scores[g] = {static_cast<uint16_t>(g), static_cast<uint16_t>(worstCase), 0,
+                         static_cast<float>(sumSquares / n), static_cast<float>(log2(n) - weightedLogs / n), 0};
+        }
+
+        // one line per tenth, from whichever worker crosses it
+        size_t before = numScored.fetch_add(end - begin);
+        size_t after = before + (end - begin);
+        if (isLogging(WordleLogLevel::INFO) && after * 10 / scores.size() != before * 10 / scores.size()) {
+            cerr << ("scored " + to_string(after) + "/" + to_string(scores.size()) + " openers\n");
+        }
+    });
+
+    // tie: an opener that could be the answer, then word ID, so the ranking never depends on timing
+    sort(scores.begin(), scores.end(), [&](const WordleOpenerScore& a, const WordleOpenerScore& b) {
+        if (a.entropy != b.entropy) return a.entropy > b.entropy;
+        bool isCandidateA = a.guess < matrix.getNumAnswers();
+        bool isCandidateB = b.guess < matrix.getNumAnswers();
+        if (isCandidateA != isCandidateB) return isCandidateA;
+        return a.guess < b.guess;
+    });
+    return openers;
+}
+
+void WordleOpeners::setSweep(size_t rank, size_t totalGuesses, size_t numSuccesses, size_t numFailures) {
+    auto& score = m_scores[rank];
+    score.averageGuesses = numSuccesses ? static_cast<double>(totalGuesses) / static_cast<double>(numSuccesses) : 0;
+    score.numFailures = numFailures;
+    m_numSwept = max(m_numSwept, rank + 1);
+}
+
+size_t WordleOpeners::getBest() const {
+    size_t best = NO_OPENER;
+    for (size_t rank = 0; rank < m_numSwept; rank++) {
+        auto& score = m_scores[rank];
+        if (score.averageGuesses == 0) {
+            continue;
+        }
+        if (best == NO_OPENER || score.numFailures < m_scores[best].numFailures ||
+            (score.numFailures == m_scores[best].numFailures && score.averageGuesses < m_scores[best].averageGuesses)) {
+            best = rank;
+        }
+    }
+    return best;
+}
+
+bool WordleOpeners::getBestFor(WordleSelectorType selectorType, string& outWord) const {
+    size_t best = getBest();
+    if (best == NO_OPENER || selectorType != m_selectorType) {
+        return false;
+    }
+    outWord = getGuess(best);
+    return true;
+}
+
+void WordleOpeners::print(size_t numRows, ostream& os) const {
+    os << "rank,guess,expected_left,entropy,worst_case,average_guesses,failures" << endl;
+    for (size_t rank = 0; rank < min(numRows, m_scores.size()); rank++) {
+        auto& score = m_scores[rank];
+        os << (rank + 1) << "," << getGuess(rank) << "," << std::setprecision(5) << score.expectedLeft << ","
+           << score.entropy << "," << score.worstCase << ",";
+        if (rank < m_numSwept) {
+            os << std::setprecision(6) << score.averageGuesses << "," << score.numFailures;
+        } else {
+            os << ",";
+        }
+        os << endl;
+    }
+}
+
+bool WordleOpeners::save(const string& filename) const {
+    auto header = WordleOpenersHeader();
+    memcpy(header.magic, OPENERS_MAGIC, sizeof(OPENERS_MAGIC));
+    header.version = OPENERS_VERSION;
+    header.letterCount = LETTER_COUNT;
+    header.numAnswers = m_answers.size();
+    header.numGuesses = m_guesses.size();
+    header.wordsHash = hashWords();
+    header.selectorType = static_cast<uint32_t>(m_selectorType);
+    header.numSwept = m_numSwept;
+    header.numScores = m_scores.size();
+
+    auto fileout = ofstream(filename, ios::binary | ios::trunc);
+    fileout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fileout.write(reinterpret_cast<const char*>(m_scores.data()), m_scores.size()*sizeof(WordleOpenerScore));
+    fileout.close();
+    if (!fileout) {
+        cerr << "Error: [openers] failed to write " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+bool WordleOpeners::load(const string& filename) {
+    auto filein = ifstream(filename, ios::binary);
+    auto header = WordleOpenersHeader();
+    if (!filein.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, OPENERS_MAGIC, sizeof(OPENERS_MAGIC)) != 0 ||
+        header.version != OPENERS_VERSION ||
+        header.letterCount != LETTER_COUNT ||
+        header.numAnswers != m_answers.size() ||
+        header.numGuesses != m_guesses.size() ||
+        header.wordsHash != hashWords() ||
+        header.numScores > header.numGuesses || header.numSwept > header.numScores ||
+        header.selectorType > static_cast<uint32_t>(WordleSelectorType::Minimax)) {
+        return false;
+    }
+
+    m_scores.resize(header.numScores);
+    if (!filein.read(reinterpret_cast<char*>(m_scores.data()), m_scores.size()*sizeof(WordleOpenerScore))) {
+        m_scores.clear();
+        return false;
+    }
+    for (auto& score : m_scores) {
+        if (score.guess >= header.numGuesses) {
+            m_scores.clear();
+            return false;
+        }
+    }
+    m_selectorType = static_cast<WordleSelectorType>(header.selectorType);
+    m_numSwept = header.numSwept;
+    // stderr, batch rows may be on stdout
+    if (isLogging(WordleLogLevel::INFO)) cerr << "Loaded openers: " << filename << endl;
+    return true;
+}
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "wordle_dictionary.h"
+#include "wordle_rules.h"
+#include "wordle_selector.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+Opener Scores
+
+Every extended guess scored as the first guess over every answer, c_p = #answers giving pattern p:
+  expected left = sum_p c_p^2 / n        (candidates left, on average)
+  entropy       = log2(n) - (1/n) * sum_p c_p*log2(c_p)
+  worst case    = max_p c_p
+Ranked by entropy, the best few are then played against every answer (`solver --mode openers`)
+ and the one with the fewest failures, then the fewest average guesses, is the best opener.
+
+Written to OPENERS_FILENAME with the selector the sweeps used. `--solver trie` opens with the
+ best opener when the file matches its dictionaries and selector.
+ */
+struct WordleOpenerScore {
+    uint16_t guess;      // guess dictionary word ID
+    uint16_t worstCase;
+    uint32_t numFailures; // from the sweep, 0 if not swept
+    float expectedLeft;
+    float entropy;
+    double averageGuesses; // from the sweep, 0 if not swept
+};
+
+struct WordleOpenersHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t letterCount;
+    uint64_t numAnswers;
+    uint64_t numGuesses;
+    uint64_t wordsHash;    // guess dictionary the word IDs refer to
+    uint32_t selectorType; // WordleSelectorType the sweeps played with
+    uint32_t numSwept;     // the first `numSwept` scores have sweep results
+    uint64_t numScores;
+};
+
+class WordleOpeners {
+public:
+    static const size_t NO_OPENER = SIZE_MAX;
+
+    // Loads OPENERS_FILENAME once, empty if missing or written for other dictionaries
+    static const WordleOpeners& getInstance();
+    // Scores every extended guess across all cores, best entropy first
+    static WordleOpeners score(WordleSelectorType selectorType);
+
+    bool load(const string& filename);
+    bool save(const string& filename) const;
+
+    // Sweep result for the opener ranked `rank`, ranks must be swept in order
+    void setSweep(size_t rank, size_t totalGuesses, size_t numSuccesses, size_t numFailures);
+    // Rank of the best swept opener, NO_OPENER if none was swept
+    size_t getBest() const;
+    // Best swept opener's word if it was swept with `selectorType`, else false
+    bool getBestFor(WordleSelectorType selectorType, string& outWord) const;
+
+    const WordleOpenerScore& getScore(size_t rank) const { return m_scores[rank]; }
+    const string& getGuess(size_t rank) const { return m_guesses.getWord(m_scores[rank].guess); }
+    size_t getNumScores() const { return m_scores.size(); }
+    size_t getNumSwept() const { return m_numSwept; }
+    WordleSelectorType getSelectorType() const { return m_selectorType; }
+    // CSV, one row per opener up to `numRows`
+    void print(size_t numRows, ostream& os=cout) const;
+private:
+    WordleOpeners();
+    uint64_t hashWords() const { return m_guesses.hashWords(m_answers.size()); }
+
+    // the extended matrix's dictionaries, the matrix itself is only built to score
+    const WordleDictionary& m_answers;
+    const WordleDictionary& m_guesses;
+    vector<WordleOpenerScore> m_scores;
+    WordleSelectorType m_selectorType{WordleSelectorType::FrequencyAndPositionalLetter};
+    size_t m_numSwept{0};
+};
+
+} // namespace WORDLE_NAMESPACE
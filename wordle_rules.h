@@ -1,21 +1,66 @@
 #pragma once
 
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #define VERSION 4.0
-#define DEBUG true
-#define DEBUG_UNICODE true
-#define PRINT_GUESSES true
+#define UNICODE_FEEDBACK true
 #define PRINT_GUESSES_SIZE 20
 #define LIGHT_MODE false
 #define DICTIONARY_FILENAME "answers.txt"
+#define EXTENDED_DICTIONARY_FILENAME "answers_extended.txt"
+#define CACHE_FILENAME "wordle.cache"
+#define TREE_FILENAME "wordle.tree"
+#define OPENERS_FILENAME "wordle.openers"
+#define TREE_ROOT_GUESSES 8
+#define TREE_NODE_GUESSES 8
 #define CREATE_SCORES_FILE false
 #define DICTIONARY_SCORES_FILENAME "scores_new.txt"
+#define VERIFY_INCREMENTAL_COUNTS false
+#define OUTPUT_WINDOW 4096
+#define STATE_CACHE_BYTES (64 << 20)
+#define STATE_CACHE_DEPTH 5
+#define TRANSPOSITION_ENTRIES (1 << 16)
+#define TRANSPOSITION_SHARDS 64
+// letters per word (4-8): the engine is built once per length as wordle_core_N, everything in it lives in
+//  namespace wordleN, and solver's main() runs the one matching the word lists
+#ifndef WORD_LENGTH
+#define WORD_LENGTH 5
+#endif
+#define WORDLE_NAMESPACE_CAT(prefix, length) prefix##length
+#define WORDLE_NAMESPACE_FOR(length) WORDLE_NAMESPACE_CAT(wordle, length)
+#define WORDLE_NAMESPACE WORDLE_NAMESPACE_FOR(WORD_LENGTH)
+// counting global operator new behind the steady-state allocation checks, read by wordle_alloc_counter.cpp only
+//  (bench and test_solver link it on): cmake -DCOUNT_HEAP_ALLOCS=true for solver too
+#ifndef COUNT_HEAP_ALLOCS
+#define COUNT_HEAP_ALLOCS false
+#endif
+
+namespace WORDLE_NAMESPACE {
 
 static size_t g_num_runs = 0; // TODO: remove, not implemented in multi-threaded
+
+// How much gets printed, from --quiet/--verbose/--trace. Rows, summaries and errors always are.
+enum class WordleLogLevel {
+    QUIET,
+    INFO,    // loading, prompts, single-game progress
+    VERBOSE, // every guess's feedback and candidate counts
+    TRACE,   // ranked guesses and candidate lists
+};
+// set once before any game starts, read-only after
+inline WordleLogLevel g_log_level = WordleLogLevel::INFO;
+// a load and a branch when off: guard the whole statement so nothing gets formatted
+inline bool isLogging(WordleLogLevel level) { return g_log_level >= level; }
 static const size_t MAX_GUESSES  = 6;
-static const size_t LETTER_COUNT = 5;
+// multi-board games get one more guess per board (Quordle: 4 boards, 9 guesses)
+static const size_t MAX_BOARDS = 16;
+static const size_t MULTI_BOARD_EXTRA_GUESSES = 5;
+static const size_t LETTER_COUNT = WORD_LENGTH;
+static_assert(LETTER_COUNT >= 4 && LETTER_COUNT <= 8, "WORD_LENGTH must be 4 to 8");
 
 enum class WordleResult {
     GREEN,
@@ -28,12 +73,66 @@ struct WordleKnown {
     WordleResult result;
 };
 
+/**
+ * Fixed-capacity stand-in for vector<T>. Storage is inline, so per-guess state
+ *  never touches the heap.
+ */
+template <typename T, size_t Capacity>
+class WordleFixedVector {
+public:
+    WordleFixedVector() = default;
+    WordleFixedVector(std::initializer_list<T> values) {
+        for (auto& value : values) {
+            push_back(value);
+        }
+    }
+
+    void push_back(const T& value) {
+        if (m_size == Capacity) {
+            std::cerr << "Error: [rules] fixed vector full" << std::endl;
+            throw;
+        }
+        m_data[m_size++] = value;
+    }
+    void clear() { m_size = 0; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    T& operator[](size_t idx) { return m_data[idx]; }
+    const T& operator[](size_t idx) const { return m_data[idx]; }
+    T* begin() { return m_data; }
+    T* end() { return m_data + m_size; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+    bool operator==(const WordleFixedVector& other) const {
+        if (m_size != other.m_size) {
+            return false;
+        }
+        for (size_t i = 0; i < m_size; i++) {
+            if (!(m_data[i] == other.m_data[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool operator!=(const WordleFixedVector& other) const { return !(*this == other); }
+private:
+    T m_data[Capacity]{};
+    size_t m_size{0};
+};
+
+using WordleResults = WordleFixedVector<WordleResult, LETTER_COUNT>;
+
+// Guess letters (nul-terminated, empty if too long to be a word) plus one result per letter
 struct WordleGuess {
-    WordleGuess(std::string cGuess, std::vector<WordleResult> cResults)
-        : guessStr(cGuess), results(cResults) {}
-    WordleGuess(std::string cGuess)
-        : guessStr(cGuess) {
-            auto results = std::vector<WordleResult>{};
+    WordleGuess(std::string_view cGuess, const WordleResults& cResults)
+        : WordleGuess(cGuess) {
+            results = cResults;
+    }
+    WordleGuess(std::string_view cGuess) {
+        if (cGuess.size() <= LETTER_COUNT) {
+            memcpy(guessStr, cGuess.data(), cGuess.size());
+        }
     }
     inline bool operator==(const WordleGuess& w1) const {
         return w1.results == results;
@@ -42,14 +141,18 @@ struct WordleGuess {
         return w1.results != results;
     }
 
-    std::string guessStr;
-    std::vector<WordleResult> results;
+    char guessStr[LETTER_COUNT + 1]{};
+    WordleResults results;
 };
 
-static auto CorrectWordleResult = std::vector<WordleResult>{WordleResult::GREEN,
-                                                            WordleResult::GREEN,
-                                                            WordleResult::GREEN,
-                                                            WordleResult::GREEN,
-                                                            WordleResult::GREEN};
+static auto CorrectWordleResult = []() {
+    auto results = WordleResults();
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        results.push_back(WordleResult::GREEN);
+    }
+    return results;
+}();
 
 static auto CorrectWordleGuess = WordleGuess("", CorrectWordleResult);
+
+} // namespace WORDLE_NAMESPACE
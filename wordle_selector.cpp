@@ -1,5 +1,11 @@
 #include "wordle_selector.h"
+#include "wordle_hard_mode.h"
+#include "wordle_rules.h"
+#include "wordle_thread_pool.h"
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -7,6 +13,44 @@
 
 using namespace std;
 
+namespace WORDLE_NAMESPACE {
+
+
+// bit per letter, for word-sized letter sets
+static uint32_t letterBit(char letter) {
+    return uint32_t(1) << letterIndex(letter);
+}
+
+WordleLetterCounts WordleLetterColumns::count() const {
+    auto counts = WordleLetterCounts();
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        size_t* histogram = counts.positions[i];
+        for (auto letter : letters[i]) {
+            histogram[letter]++;
+        }
+        for (size_t c = 0; c < ALPHABET_SIZE; c++) {
+            counts.letters[c] += histogram[c];
+        }
+    }
+    return counts;
+}
+
+void WordleLetterColumns::score(const WordleLetterWeights& weights, vector<uint32_t>& outScores) const {
+    size_t numWords = size();
+    outScores.assign(numWords, 0);
+    uint8_t skipped = weights.isRepeatScored ? 0 : 0xFF;
+    uint32_t* scores = outScores.data();
+    const uint8_t* wordRepeats = repeats.data();
+    // a column at a time, the same 26-entry row for every word
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        const uint32_t* row = weights.positions[i];
+        const uint8_t* column = letters[i].data();
+        for (size_t w = 0; w < numWords; w++) {
+            uint32_t isScored = ((wordRepeats[w] & skipped) >> i & 1) ^ 1;
+            scores[w] += row[column[w]] * isScored;
+        }
+    }
+}
 
 template <typename IterType>
 string RandomWordleSelector<IterType>::select(IterType begin, IterType end, size_t rangeSize,
@@ -62,6 +106,14 @@ bool EnhancedRandomWordleSelector<IterType>::containsOneVowel(const string& word
 
 ////////////////
 
+template <typename IterType>
+MostCommonLetterWordleSelector<IterType>::MostCommonLetterWordleSelector() {
+    // every range a select gets is drawn from the answers, so the columns never grow
+    size_t maxWords = WordleDictionary::getAnswers().size();
+    m_columns.reserve(maxWords);
+    m_scores.reserve(maxWords);
+}
+
 template <typename IterType>
 string MostCommonLetterWordleSelector<IterType>::select(IterType begin, IterType end, size_t rangeSize,
                                                   const vector<WordleKnown>& knowns, size_t guessNum) {
@@ -71,18 +123,24 @@ string MostCommonLetterWordleSelector<IterType>::select(IterType begin, IterType
     m_iterBegin = begin;
     m_iterEnd = end;
     computeFrequencyMap();
-#if PRINT_GUESSES == true
-    printCandidates();
-#endif
+    if (isLogging(WordleLogLevel::TRACE)) {
+        printCandidates();
+    }
     return getBestCandidate();
 }
 
 template <typename IterType>
 void MostCommonLetterWordleSelector<IterType>::clearOldState() {
     m_knowns.clear();
-    m_frequencyMapLetter.clear();
-    m_wordScore.clear();
-    m_sortedWords.clear();
+    m_numRanked = 0;
+}
+
+template <typename IterType>
+void MostCommonLetterWordleSelector<IterType>::reset() {
+    WordleSelector<IterType>::reset();
+    m_knowns.clear();
+    m_hasCounts = false;
+    m_numRanked = 0;
 }
 
 template <typename IterType>
@@ -112,281 +170,517 @@ bool MostCommonLetterWordleSelector<IterType>::containsAllHints(const string& wo
 
 template <typename IterType>
 void MostCommonLetterWordleSelector<IterType>::printCandidates() const {
-    cout << "Remaining Candidates: (" << m_sortedWords.size() << ")" << endl;
-    size_t i = 0;
-    for (auto it = m_sortedWords.begin(); it != m_sortedWords.end(); it++) {
-        cout << " " << it->word << ":" << it->score << endl;
-        i++;
-
-        if (i == PRINT_GUESSES_SIZE) {
-            cout << "... (" << (m_sortedWords.size() - PRINT_GUESSES_SIZE) << ") skipped" << endl;
-            break;
-        }
+    cout << "Remaining Candidates: (" << m_columns.size() << ")" << endl;
+    for (size_t r = 0; r < m_numRanked; r++) {
+        cout << " " << *m_columns.words[m_ranked[r]] << ":" << m_scores[m_ranked[r]] << endl;
+    }
+    if (m_columns.size() > m_numRanked) {
+        cout << "... (" << (m_columns.size() - m_numRanked) << ") skipped" << endl;
     }
 }
 
 template <typename IterType>
 string MostCommonLetterWordleSelector<IterType>::getBestCandidate() const {
-    auto it = m_sortedWords.begin();
     // for (;!containsAllHints(it->word); it++) {
     //     cout << "nope." << endl;
     // }
-    return it->word;
+    return *m_columns.words[m_ranked[0]];
 }
 
 template <typename IterType>
 char MostCommonLetterWordleSelector<IterType>::getMostCommonLetter() const {
     size_t highest = 0;
     char mostCommon = '0';
-    for (auto it = m_frequencyMapLetter.begin(); it != m_frequencyMapLetter.end(); it++) {
-        if (it->second > highest) {
-            highest = it->second;
-            mostCommon = it->first;
+    for (size_t c = 0; c < ALPHABET_SIZE; c++) {
+        if (m_counts.letters[c] > highest) {
+            highest = m_counts.letters[c];
+            mostCommon = static_cast<char>('a' + c);
         }
     }
 
     if (!mostCommon) {
-        if (DEBUG) cerr << "Error: [selector] no most common letter" << endl;
+        cerr << "Error: [selector] no most common letter" << endl;
         throw;
     }
 
     return mostCommon;
 }
 
+template <typename IterType>
+void MostCommonLetterWordleSelector<IterType>::updateCounts() {
+    if constexpr (is_same_v<IterType, CandidateIterator>) {
+        const WordleBitset* bits = m_iterBegin.getBits();
+        if (m_hasCounts && m_iterBegin.getWords() == m_countedWordList && bits->isSubsetOf(m_countedWords)) {
+            m_countedWords.forEachNotIn(*bits, [this](size_t wordId) {
+                m_counts.remove((*m_countedWordList)[wordId]);
+            });
+            m_countedWords = *bits;
+#if VERIFY_INCREMENTAL_COUNTS == true
+            if (!(m_counts == WordleLetterCounts::count(m_iterBegin, m_iterEnd))) {
+                cerr << "Error: [selector] incremental letter counts differ from recount" << endl;
+                throw;
+            }
+#endif
+            return;
+        }
+        m_hasCounts = true;
+        m_countedWords = *bits;
+        m_countedWordList = m_iterBegin.getWords();
+    }
+    m_counts = m_columns.count();
+}
+
 template <typename IterType>
 void MostCommonLetterWordleSelector<IterType>::computeFrequencyMap() {
-    if (m_alphabetWordScore.size() == 0) {
-        computeFrequencyMapInternal(m_alphabetFrequencyMapLetter, m_alphabetWordScore);
-        m_frequencyMapLetter = m_alphabetFrequencyMapLetter;
-        m_wordScore = m_alphabetWordScore;
-    } else {
-        computeFrequencyMapInternal(m_frequencyMapLetter, m_wordScore);
+    m_columns.assign(m_iterBegin, m_iterEnd);
+    updateCounts();
+    m_weights = WordleLetterWeights();
+    computeLetterWeights(m_weights);
+    m_columns.score(m_weights, m_scores);
+#if CREATE_SCORES_FILE == true
+    if (m_isScoresFileGuess) {
+        writeScoresFile();
     }
-    sortWordsByFrequency();
+#endif
+    rankWordsByFrequency();
 }
 
 template <typename IterType>
-void MostCommonLetterWordleSelector<IterType>::sortWordsByFrequency() {
-    for (auto wordIt = m_wordScore.begin(); wordIt != m_wordScore.end(); wordIt++) {
-        auto ws = WordScore();
-        ws.word = wordIt->first;
-        ws.score = wordIt->second;
-        m_sortedWords.insert(ws);
+void MostCommonLetterWordleSelector<IterType>::rankWordsByFrequency() {
+    size_t numKept = isLogging(WordleLogLevel::TRACE) ? PRINT_GUESSES_SIZE : 1;
+    auto byRank = [this](uint32_t w1, uint32_t w2) { return isBetter(w1, w2); };
+    // one pass, a heap of the best so far ordered by rank, so the worst of them is on top
+    m_numRanked = 0;
+    for (uint32_t w = 0; w < m_columns.size(); w++) {
+        if (m_numRanked < numKept) {
+            m_ranked[m_numRanked++] = w;
+            push_heap(m_ranked.begin(), m_ranked.begin() + m_numRanked, byRank);
+        } else if (isBetter(w, m_ranked[0])) {
+            pop_heap(m_ranked.begin(), m_ranked.begin() + m_numRanked, byRank);
+            m_ranked[m_numRanked - 1] = w;
+            push_heap(m_ranked.begin(), m_ranked.begin() + m_numRanked, byRank);
+        }
     }
+    sort_heap(m_ranked.begin(), m_ranked.begin() + m_numRanked, byRank);
 }
 
 template <typename IterType>
-void NaiveMostCommonLetterWordleSelector<IterType>::computeFrequencyMapInternal(unordered_map<char, size_t>& letterMap,
-                                                                          unordered_map<string, size_t>& wordScore) {
-    // Compute letter scores
-    for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-        for (auto& c : *wordIt) {
-            if (letterMap.find(c) == letterMap.end()) {
-                letterMap[c] = 0;
-            }
-            letterMap[c]++;
+bool MostCommonLetterWordleSelector<IterType>::isBetter(uint32_t w1, uint32_t w2) const {
+    if (m_scores[w1] != m_scores[w2]) {
+        return m_scores[w1] > m_scores[w2];
+    }
+    return *m_columns.words[w1] < *m_columns.words[w2];
+}
+
+#if CREATE_SCORES_FILE == true
+template <typename IterType>
+void MostCommonLetterWordleSelector<IterType>::writeScoresFile() const {
+    auto file_stream = ofstream(DICTIONARY_SCORES_FILENAME);
+    for (size_t w = 0; w < m_columns.size(); w++) {
+        file_stream << *m_columns.words[w] << ":";
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            file_stream << m_weights.positions[i][m_columns.letters[i][w]] << ",";
         }
+        file_stream << " = " << m_scores[w] << endl;
     }
+}
+#endif
 
-    // Compute word scores
-    for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-        size_t score = 0;
-        set<char> wordLetters;
-        for (auto& c : *wordIt) {
-            if (wordLetters.find(c) == wordLetters.end()) {
-                wordLetters.insert(c);
-                score += letterMap[c];
-            }
+// bit per letter known green somewhere
+static uint32_t getGreenLetters(const vector<WordleKnown>& knowns) {
+    uint32_t greenLetters = 0;
+    for (auto& known : knowns) {
+        if (known.result == WordleResult::GREEN) {
+            greenLetters |= letterBit(known.letter);
         }
-        wordScore.insert({*wordIt, score});
     }
+    return greenLetters;
 }
 
 template <typename IterType>
-void ImprovedMostCommonLetterWordleSelector<IterType>::computeFrequencyMapInternal(unordered_map<char, size_t>& letterMap,
-                                                                             unordered_map<string, size_t>& wordScore) {
-    // Compute letter scores
-    for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-        for (auto& c : *wordIt) {
-            if (letterMap.find(c) == letterMap.end()) {
-                letterMap[c] = 0;
-            }
-            letterMap[c]++;
+void NaiveMostCommonLetterWordleSelector<IterType>::computeLetterWeights(WordleLetterWeights& weights) {
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        for (size_t c = 0; c < ALPHABET_SIZE; c++) {
+            weights.positions[i][c] = this->m_counts.letters[c];
         }
     }
+}
 
-    // Compute word scores
-    for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-        size_t score = 0;
-        set<char> wordLetters;
-        set<char> greenLetters;
-        for (size_t i = 0; i < this->m_knowns.size(); i++) {
-            if (this->m_knowns[i].result == WordleResult::GREEN) {
-                greenLetters.insert(this->m_knowns[i].letter);
-            }
+template <typename IterType>
+void ImprovedMostCommonLetterWordleSelector<IterType>::computeLetterWeights(WordleLetterWeights& weights) {
+    uint32_t greenLetters = getGreenLetters(this->m_knowns);
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        // only give scores to each letter that isn't already known
+        if (this->m_knowns[i].result == WordleResult::GREEN) {
+            continue;
         }
-        size_t i = 0;
-        for (auto& c : *wordIt) {
-            // only give scores to each letter once
-            if (wordLetters.find(c) == wordLetters.end()) {
-                // only give scores to each letter that isn't already known
-                if (this->m_knowns[i].result != WordleResult::GREEN) {
-                    if (greenLetters.find(c) == greenLetters.end()) {
-                        score += letterMap[c];
-                    }
-                }
+        for (size_t c = 0; c < ALPHABET_SIZE; c++) {
+            if (!(greenLetters & (uint32_t(1) << c))) {
+                weights.positions[i][c] = this->m_counts.letters[c];
             }
-            wordLetters.insert(c);
-            i++;
         }
-        wordScore.insert({*wordIt, score});
     }
 }
 
 template <typename IterType>
-void PositionalLetterWordleSelector<IterType>::computeFrequencyMapInternal(unordered_map<char, size_t>& unused_letterMap,
-                                                                     unordered_map<string, size_t>& wordScore) {
-    // Compute positional letter scores
+void PositionalLetterWordleSelector<IterType>::computeLetterWeights(WordleLetterWeights& weights) {
+    uint32_t greenLetters = getGreenLetters(this->m_knowns);
+    // only give scores to each letter once // for the opening 2 rounds
+    weights.isRepeatScored = this->m_guessNum >= 6;
     for (size_t i = 0; i < LETTER_COUNT; i++) {
-        auto letterMap = unordered_map<char, size_t>();
-        for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-            char c = (*wordIt)[i];
-            if (letterMap.find(c) == letterMap.end()) {
-                letterMap[c] = 0;
+        for (size_t c = 0; c < ALPHABET_SIZE; c++) {
+            if (!(greenLetters & (uint32_t(1) << c))) {
+                weights.positions[i][c] = this->m_counts.positions[i][c];
             }
-            letterMap[c]++;
         }
-        m_positionLetterScores.push_back(letterMap);
     }
-
-    // Compute word scores & write to file
 #if CREATE_SCORES_FILE == true
-    ofstream file_stream;
-    if (m_initialGuess && g_num_runs == 0) {
-        file_stream.open(DICTIONARY_SCORES_FILENAME);
-    }
+    this->m_isScoresFileGuess = m_initialGuess && g_num_runs == 0;
 #endif
-    for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-        size_t score = 0;
-        set<char> wordLetters;
-        set<char> greenLetters;
-        for (size_t i = 0; i < this->m_knowns.size(); i++) {
-            if (this->m_knowns[i].result == WordleResult::GREEN) {
-                greenLetters.insert(this->m_knowns[i].letter);
+    m_initialGuess = false;
+}
+
+template <typename IterType>
+void PositionalLetterWordleSelector<IterType>::reset() {
+    MostCommonLetterWordleSelector<IterType>::reset();
+    m_initialGuess = true;
+}
+
+template <typename IterType>
+void FrequencyAndPositionalLetterWordleSelector<IterType>::computeLetterWeights(WordleLetterWeights& weights) {
+    uint32_t greenLetters = getGreenLetters(this->m_knowns);
+    // only give scores to each letter once
+    weights.isRepeatScored = this->m_guessNum >= 6;
+    for (size_t i = 0; i < LETTER_COUNT; i++) {
+        for (size_t c = 0; c < ALPHABET_SIZE; c++) {
+            if (!(greenLetters & (uint32_t(1) << c))) {
+                weights.positions[i][c] = this->m_counts.positions[i][c] + 2*this->m_counts.letters[c];
             }
         }
-        size_t i = 0;
-#if CREATE_SCORES_FILE == true
-        if (m_initialGuess && g_num_runs == 0) {
-            file_stream << *wordIt << ":";
-        }
-#endif
-        for (auto& c : *wordIt) {
-            // only give scores to each letter once // for the opening 2 rounds
-            if ((wordLetters.find(c) == wordLetters.end() && this->m_guessNum < 6) || this->m_guessNum >= 6) {
-                // only give scores to each letter that isn't already known
-                //if (this->m_knowns[i].result != WordleResult::GREEN) {
-                    if (greenLetters.find(c) == greenLetters.end()) {
-                        score += m_positionLetterScores[i][c];
-                    }
-                    //}
-            }
+    }
 #if CREATE_SCORES_FILE == true
-            if (m_initialGuess && g_num_runs == 0) {
-                file_stream << m_positionLetterScores[i][c] << ",";
-            }
+    this->m_isScoresFileGuess = this->m_initialGuess && g_num_runs == 0;
 #endif
-            wordLetters.insert(c);
-            i++;
+    this->m_initialGuess = false;
+}
+
+////////////////
+
+// Below this many matrix lookups per thread, splitting the search costs more than it saves
+static const size_t SELECTOR_MIN_LOOKUPS_PER_THREAD = 1 << 18;
+
+template <typename IterType>
+EntropyWordleSelector<IterType>::EntropyWordleSelector(bool useExtendedGuesses)
+    : m_matrix(useExtendedGuesses ? WordleFeedbackMatrix::getExtendedMatrix() : WordleFeedbackMatrix::getAnswersMatrix()),
+      m_pool(WordleThreadPool::getShared()) {
+    m_weightedLogs.push_back(0);
+    for (size_t n = 1; n <= m_matrix.getNumAnswers(); n++) {
+        m_weightedLogs.push_back(n * log2(static_cast<double>(n)));
+    }
+    m_scores.resize(m_matrix.getNumGuesses());
+    m_answerIdxs.reserve(m_matrix.getNumAnswers());
+    m_ranked.reserve(m_matrix.getNumGuesses());
+}
+
+template <typename IterType>
+string EntropyWordleSelector<IterType>::select(IterType begin, IterType end, size_t rangeSize,
+                                         const vector<WordleKnown>& knowns, size_t guessNum) {
+    this->m_guessNum = guessNum;
+    m_answerIdxs.clear();
+    m_isCandidate.assign(m_matrix.getNumAnswers(), false);
+    for (auto wordIt = begin; wordIt != end; wordIt++) {
+        size_t answerIdx;
+        if (m_matrix.getAnswerIndex(*wordIt, answerIdx)) {
+            m_answerIdxs.push_back(answerIdx);
+            m_isCandidate[answerIdx] = true;
         }
-#if CREATE_SCORES_FILE == true
-        if (m_initialGuess && g_num_runs == 0) {
-            file_stream << " = " << score << endl;
+    }
+
+    if (m_answerIdxs.size() == 0) {
+        cerr << "Error: [selector] no candidates in feedback matrix" << endl;
+        throw;
+    }
+    if (m_answerIdxs.size() <= 2) {
+        return m_matrix.getAnswer(m_answerIdxs[0]);
+    }
+
+    size_t numGuesses = m_matrix.getNumGuesses();
+    size_t numThreads = min<size_t>(m_pool.getNumWorkers(),
+                                    (numGuesses * m_answerIdxs.size()) / SELECTOR_MIN_LOOKUPS_PER_THREAD);
+    if (m_answerIdxs.size() == m_matrix.getNumAnswers() && m_matrix.getFirstGuessScores()) {
+        // nothing ruled out yet, scores were precomputed into the cache file
+        copy(m_matrix.getFirstGuessScores(), m_matrix.getFirstGuessScores() + numGuesses, m_scores.begin());
+    } else if (numThreads <= 1 || WordleThreadPool::isWorkerThread()) {
+        // sweep workers already keep every core busy
+        scoreGuesses(0, numGuesses);
+    } else {
+        // a chunk per thread the search is worth, on workers that outlive the select
+        size_t chunk = (numGuesses + numThreads - 1) / numThreads;
+        m_pool.run(numGuesses, chunk, [this](size_t unused_workerIdx, size_t guessBegin, size_t guessEnd) {
+            scoreGuesses(guessBegin, guessEnd);
+        });
+    }
+
+    // a candidate reuses every hint, so it's always allowed
+    size_t best = m_answerIdxs[0];
+    for (size_t g = nextAllowed(0); g < numGuesses; g = nextAllowed(g + 1)) {
+        if (isBetter(g, best)) {
+            best = g;
         }
-#endif
-        wordScore.insert({*wordIt, score});
     }
 
-    m_initialGuess = false;
+    if (isLogging(WordleLogLevel::TRACE)) {
+        printCandidates();
+    }
+    return m_matrix.getGuess(best);
 }
 
 template <typename IterType>
-void PositionalLetterWordleSelector<IterType>::clearOldState() {
-    MostCommonLetterWordleSelector<IterType>::clearOldState();
-    m_positionLetterScores.clear();
+void EntropyWordleSelector<IterType>::scoreGuesses(size_t guessBegin, size_t guessEnd) {
+    uint32_t counts[FEEDBACK_PATTERNS];
+    for (size_t g = nextAllowed(guessBegin); g < guessEnd; g = nextAllowed(g + 1)) {
+        m_matrix.computeHistogram(g, m_answerIdxs, counts);
+        double score = 0;
+        for (size_t p = 0; p < FEEDBACK_PATTERNS; p++) {
+            score += m_weightedLogs[counts[p]];
+        }
+        m_scores[g] = score;
+    }
 }
 
 template <typename IterType>
-void FrequencyAndPositionalLetterWordleSelector<IterType>::computeFrequencyMapInternal(unordered_map<char, size_t>& unused_letterMap,
-                                                                                 unordered_map<string, size_t>& wordScore) {
-    // Compute positional letter scores
-    for (size_t i = 0; i < LETTER_COUNT; i++) {
-        auto letterMap = unordered_map<char, size_t>();
-        for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-            char c = (*wordIt)[i];
-            if (letterMap.find(c) == letterMap.end()) {
-                letterMap[c] = 0;
-            }
-            letterMap[c]++;
+bool EntropyWordleSelector<IterType>::isBetter(size_t guessIdx, size_t bestIdx) const {
+    if (m_scores[guessIdx] != m_scores[bestIdx]) {
+        return m_scores[guessIdx] < m_scores[bestIdx];
+    }
+    // tie: prefer a guess that could be the answer
+    bool isCandidate = guessIdx < m_isCandidate.size() && m_isCandidate[guessIdx];
+    bool isBestCandidate = bestIdx < m_isCandidate.size() && m_isCandidate[bestIdx];
+    return isCandidate && !isBestCandidate;
+}
+
+template <typename IterType>
+size_t EntropyWordleSelector<IterType>::nextAllowed(size_t guessIdx) const {
+    if (!this->m_hardMode) {
+        return guessIdx;
+    }
+    // answers come first in both guess lists, so IDs agree with the extended dictionary's
+    return this->m_hardMode->getAllowed().findNext(guessIdx);
+}
+
+template <typename IterType>
+double EntropyWordleSelector<IterType>::getEntropy(size_t guessIdx) const {
+    double n = static_cast<double>(m_answerIdxs.size());
+    return log2(n) - m_scores[guessIdx] / n;
+}
+
+template <typename IterType>
+void EntropyWordleSelector<IterType>::printCandidates() {
+    auto& ranked = m_ranked;
+    ranked.clear();
+    for (size_t g = nextAllowed(0); g < m_matrix.getNumGuesses(); g = nextAllowed(g + 1)) {
+        ranked.push_back(g);
+    }
+    size_t shown = min<size_t>(PRINT_GUESSES_SIZE, ranked.size());
+    partial_sort(ranked.begin(), ranked.begin() + shown, ranked.end(), [this](size_t a, size_t b) {
+        return isBetter(a, b) || (!isBetter(b, a) && a < b);
+    });
+
+    cout << "Remaining Candidates: (" << m_answerIdxs.size() << ")" << endl;
+    for (size_t i = 0; i < shown; i++) {
+        cout << " " << m_matrix.getGuess(ranked[i]) << ":" << getEntropy(ranked[i]) << endl;
+    }
+}
+
+////////////////
+
+// Candidates per live block above which the all-black bound pays for itself
+static const size_t MINIMAX_CANDIDATES_PER_BLOCK = 8;
+
+template <typename IterType>
+MinimaxWordleSelector<IterType>::MinimaxWordleSelector()
+    : m_matrix(WordleFeedbackMatrix::getExtendedMatrix()), m_pool(WordleThreadPool::getShared()),
+      m_numBlocks((m_matrix.getNumAnswers() + 63) / 64), m_bests(m_pool.getNumWorkers()) {
+    auto letterSet = [](const string& word) {
+        uint32_t letters = 0;
+        for (char c : word) {
+            letters |= letterBit(c);
+        }
+        return letters;
+    };
+    m_letterBlocks.assign(ALPHABET_SIZE * m_numBlocks, 0);
+    for (size_t a = 0; a < m_matrix.getNumAnswers(); a++) {
+        for (uint32_t rest = letterSet(m_matrix.getAnswer(a)); rest != 0; rest &= rest - 1) {
+            m_letterBlocks[countr_zero(rest) * m_numBlocks + a / 64] |= uint64_t(1) << (a % 64);
         }
-        m_positionLetterScores.push_back(letterMap);
     }
+    m_guessLetters.reserve(m_matrix.getNumGuesses());
+    for (size_t g = 0; g < m_matrix.getNumGuesses(); g++) {
+        m_guessLetters.push_back(letterSet(m_matrix.getGuess(g)));
+    }
+    m_answerIdxs.reserve(m_matrix.getNumAnswers());
+    m_candidateBlocks.reserve(m_numBlocks);
+    m_liveBlocks.reserve(m_numBlocks);
+}
 
-    // Compute letter scores
-    for (size_t i = 0; i < LETTER_COUNT; i++) {
-        for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-            char c = (*wordIt)[i];
-            if (m_fullLetterMap.find(c) == m_fullLetterMap.end()) {
-                m_fullLetterMap[c] = 0;
-            }
-            m_fullLetterMap[c]++;
+template <typename IterType>
+string MinimaxWordleSelector<IterType>::select(IterType begin, IterType end, size_t rangeSize,
+                                         const vector<WordleKnown>& knowns, size_t guessNum) {
+    this->m_guessNum = guessNum;
+    m_answerIdxs.clear();
+    m_isCandidate.assign(m_matrix.getNumAnswers(), false);
+    for (auto wordIt = begin; wordIt != end; wordIt++) {
+        size_t answerIdx;
+        if (m_matrix.getAnswerIndex(*wordIt, answerIdx)) {
+            m_answerIdxs.push_back(answerIdx);
+            m_isCandidate[answerIdx] = true;
         }
     }
 
-    // Compute word scores & write to file
-#if CREATE_SCORES_FILE == true
-    ofstream file_stream;
-    if (m_initialGuess && g_num_runs == 0) {
-        file_stream.open(DICTIONARY_SCORES_FILENAME);
+    if (m_answerIdxs.size() == 0) {
+        cerr << "Error: [selector] no candidates in feedback matrix" << endl;
+        throw;
     }
-#endif
-    for (auto wordIt = this->m_iterBegin; wordIt != this->m_iterEnd; wordIt++) {
-        size_t score = 0;
-        set<char> wordLetters;
-        set<char> greenLetters;
-        for (size_t i = 0; i < this->m_knowns.size(); i++) {
-            if (this->m_knowns[i].result == WordleResult::GREEN) {
-                greenLetters.insert(this->m_knowns[i].letter);
+    if (m_answerIdxs.size() <= 2) {
+        return m_matrix.getAnswer(m_answerIdxs[0]);
+    }
+
+    // nothing ruled out yet: every game opens the same way, hard mode or not
+    bool isOpener = m_answerIdxs.size() == m_matrix.getNumAnswers();
+    if (isOpener && m_hasOpener) {
+        return m_matrix.getGuess(m_opener.guessIdx);
+    }
+
+    m_candidateBlocks.assign(m_numBlocks, 0);
+    for (auto answerIdx : m_answerIdxs) {
+        m_candidateBlocks[answerIdx / 64] |= uint64_t(1) << (answerIdx % 64);
+    }
+    m_liveBlocks.clear();
+    for (size_t b = 0; b < m_numBlocks; b++) {
+        if (m_candidateBlocks[b] != 0) {
+            m_liveBlocks.push_back(b);
+        }
+    }
+    // the mask bound costs about a lookup per live block and letter, worth it only for dense candidates
+    m_isBlackBounded = m_answerIdxs.size() >= MINIMAX_CANDIDATES_PER_BLOCK * m_liveBlocks.size();
+
+    size_t numGuesses = m_matrix.getNumGuesses();
+    size_t numThreads = min<size_t>(m_pool.getNumWorkers(),
+                                    (numGuesses * m_answerIdxs.size()) / SELECTOR_MIN_LOOKUPS_PER_THREAD);
+    m_bound = static_cast<uint32_t>(m_answerIdxs.size());
+    // a candidate reuses every hint, so it's always allowed, and no partition is bigger than every candidate
+    Score best{m_answerIdxs[0], UINT32_MAX, UINT64_MAX, true};
+    if (numThreads <= 1 || WordleThreadPool::isWorkerThread()) {
+        // sweep workers already keep every core busy
+        scoreGuesses(0, numGuesses, &best);
+    } else {
+        // a chunk per thread the search is worth on the shared pool, every chunk tightening m_bound for the rest
+        fill(m_bests.begin(), m_bests.end(), best);
+        size_t chunk = (numGuesses + numThreads - 1) / numThreads;
+        m_pool.run(numGuesses, chunk, [this](size_t workerIdx, size_t guessBegin, size_t guessEnd) {
+            scoreGuesses(guessBegin, guessEnd, &m_bests[workerIdx]);
+        });
+        for (auto& score : m_bests) {
+            if (isBetter(score, best)) {
+                best = score;
             }
         }
-        size_t i = 0;
-#if CREATE_SCORES_FILE == true
-        if (m_initialGuess && g_num_runs == 0) {
-            file_stream << *wordIt << ":";
+    }
+
+    if (isOpener) {
+        m_opener = best;
+        m_hasOpener = true;
+    }
+    if (isLogging(WordleLogLevel::TRACE)) {
+        cout << "Minimax: " << m_matrix.getGuess(best.guessIdx) << " leaves at most " << best.maxPartition
+             << " of " << m_answerIdxs.size() << " candidates, "
+             << static_cast<double>(best.sumSquares) / static_cast<double>(m_answerIdxs.size()) << " expected" << endl;
+    }
+    return m_matrix.getGuess(best.guessIdx);
+}
+
+template <typename IterType>
+void MinimaxWordleSelector<IterType>::scoreGuesses(size_t guessBegin, size_t guessEnd, Score* outBest) {
+    // only the patterns that turn up are visited and cleared, small candidate sets touch few
+    uint32_t counts[FEEDBACK_PATTERNS] = {};
+    feedback_t touched[FEEDBACK_PATTERNS];
+    for (size_t g = nextAllowed(guessBegin); g < guessEnd; g = nextAllowed(g + 1)) {
+        // strictly worse only: guesses that tie the bound are counted in full for the tiebreaks
+        uint32_t bound = m_bound.load(memory_order_relaxed);
+        if (m_isBlackBounded && countAllBlack(m_guessLetters[g]) > bound) {
+            continue;
         }
-#endif
-        for (auto& c : *wordIt) {
-            // only give scores to each letter once
-            if ((wordLetters.find(c) == wordLetters.end() && this->m_guessNum < 6) || this->m_guessNum >= 6) {
-                if (greenLetters.find(c) == greenLetters.end()) {
-                    score += (m_positionLetterScores[i][c] + 2*m_fullLetterMap[c]);
-                }
+        const feedback_t* row = m_matrix.getRow(g);
+        uint32_t maxPartition = 0;
+        size_t numTouched = 0;
+        for (auto answerIdx : m_answerIdxs) {
+            feedback_t feedback = row[answerIdx];
+            uint32_t count = ++counts[feedback];
+            if (count == 1) {
+                touched[numTouched++] = feedback;
             }
-#if CREATE_SCORES_FILE == true
-            if (m_initialGuess && g_num_runs == 0) {
-                file_stream << (m_positionLetterScores[i][c] + 2*m_fullLetterMap[c]) << ",";
+            if (count > maxPartition) {
+                maxPartition = count;
+                if (maxPartition > bound) {
+                    break;
+                }
             }
-#endif
-            wordLetters.insert(c);
-            i++;
         }
-#if CREATE_SCORES_FILE == true
-        if (m_initialGuess && g_num_runs == 0) {
-            file_stream << " = " << score << endl;
+
+        uint64_t sumSquares = 0;
+        for (size_t t = 0; t < numTouched; t++) {
+            sumSquares += static_cast<uint64_t>(counts[touched[t]]) * counts[touched[t]];
+            counts[touched[t]] = 0;
         }
-#endif
-        wordScore.insert({*wordIt, score});
+        if (maxPartition > bound) {
+            continue;
+        }
+
+        auto score = Score{g, maxPartition, sumSquares, g < m_isCandidate.size() && m_isCandidate[g]};
+        if (isBetter(score, *outBest)) {
+            *outBest = score;
+        }
+        // tighten the shared bound for every thread
+        uint32_t shared = m_bound.load(memory_order_relaxed);
+        while (maxPartition < shared && !m_bound.compare_exchange_weak(shared, maxPartition, memory_order_relaxed)) {}
     }
+}
 
-    m_initialGuess = false;
+template <typename IterType>
+uint32_t MinimaxWordleSelector<IterType>::countAllBlack(uint32_t letters) const {
+    uint32_t count = 0;
+    for (auto b : m_liveBlocks) {
+        uint64_t block = m_candidateBlocks[b];
+        for (uint32_t rest = letters; rest != 0; rest &= rest - 1) {
+            block &= ~m_letterBlocks[countr_zero(rest) * m_numBlocks + b];
+        }
+        count += popcount(block);
+    }
+    return count;
 }
+
+template <typename IterType>
+bool MinimaxWordleSelector<IterType>::isBetter(const Score& score, const Score& best) {
+    if (score.maxPartition != best.maxPartition) {
+        return score.maxPartition < best.maxPartition;
+    }
+    if (score.sumSquares != best.sumSquares) {
+        return score.sumSquares < best.sumSquares;
+    }
+    // tie: prefer a guess that could be the answer, then the first in the list
+    if (score.isCandidate != best.isCandidate) {
+        return score.isCandidate;
+    }
+    return score.guessIdx < best.guessIdx;
+}
+
+template <typename IterType>
+size_t MinimaxWordleSelector<IterType>::nextAllowed(size_t guessIdx) const {
+    if (!this->m_hardMode) {
+        return guessIdx;
+    }
+    // answers come first in both guess lists, so IDs agree with the extended dictionary's
+    return this->m_hardMode->getAllowed().findNext(guessIdx);
+}
+
+} // namespace WORDLE_NAMESPACE
@@ -1,15 +1,24 @@
 #pragma once
 
+#include "wordle_candidates.h"
+#include "wordle_feedback.h"
 #include "wordle_rules.h"
+#include "wordle_thread_pool.h"
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <set>
 #include <string>
-#include <unordered_map>
 
 using namespace std;
 
+namespace WORDLE_NAMESPACE {
+
+
+class WordleHardMode;
 
 using ForwardIterator = vector<string>::iterator;
 using SetIterator = set<string>::iterator;
@@ -18,14 +27,22 @@ template <typename IterType>
 class WordleSelector {
 public:
     WordleSelector() { srand(time(nullptr)); }
+    virtual ~WordleSelector() {}
     virtual string select(IterType begin, IterType end, size_t rangeSize, const vector<WordleKnown>& knowns, size_t guessNum) = 0;
+    // Back to the state before the first select
+    virtual void reset() { m_guessNum = 0; }
+    // Hard mode: only guesses `hardMode` allows, nullptr for any. Selectors that pick from the
+    //  candidates are already covered, a candidate gave every hint so far and reuses them all.
+    void setHardMode(const WordleHardMode* hardMode) { m_hardMode = hardMode; }
 protected:
     size_t m_guessNum{0};
+    const WordleHardMode* m_hardMode{nullptr};
 };
 
 template <typename IterType>
 class RandomWordleSelector : public WordleSelector<IterType> {
 public:
+    using WordleSelector<IterType>::WordleSelector;
     string select(IterType begin, IterType end, size_t rangeSize, const vector<WordleKnown>& knowns, size_t guessNum) override;
 private:
     size_t getRandom(IterType begin, IterType end, size_t rangeSize) const;
@@ -34,6 +51,7 @@ private:
 template <typename IterType>
 class EnhancedRandomWordleSelector : public RandomWordleSelector<IterType> {
 public:
+    using RandomWordleSelector<IterType>::RandomWordleSelector;
     string select(IterType begin, IterType end, size_t rangeSize, const vector<WordleKnown>& knowns, size_t guessNum) override;
 private:
     bool containsDoubleLetter(const string& word) const;
@@ -41,81 +59,257 @@ private:
     bool containsOneVowel(const string& word) const;
 };
 
-///////////////
+/////////////////
 
-struct WordScore {
-    WordScore() : word(), lowestLetterScore(0), score(0) {}
-    string word;
-    size_t lowestLetterScore;
-    size_t score;
-};
+/**
+ * Letter counts over a set of words, kept current by adding/removing single words:
+ *   letters[c]      occurrences of letter c, at any position
+ *   positions[i][c] words with letter c at position i
+ */
+struct WordleLetterCounts {
+    size_t letters[ALPHABET_SIZE]{};
+    size_t positions[LETTER_COUNT][ALPHABET_SIZE]{};
 
-struct WordScoreComp {
-    bool operator() (const WordScore& w1, const WordScore& w2) const {
-        return w1.score > w2.score;
+    void add(const string& word) {
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            letters[letterIndex(word[i])]++;
+            positions[i][letterIndex(word[i])]++;
+        }
+    }
+    void remove(const string& word) {
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            letters[letterIndex(word[i])]--;
+            positions[i][letterIndex(word[i])]--;
+        }
+    }
+    bool operator==(const WordleLetterCounts& other) const { return memcmp(this, &other, sizeof(*this)) == 0; }
+
+    template <typename IterType>
+    static WordleLetterCounts count(IterType begin, IterType end) {
+        auto counts = WordleLetterCounts();
+        for (auto wordIt = begin; wordIt != end; wordIt++) {
+            counts.add(*wordIt);
+        }
+        return counts;
     }
 };
 
-/////////////////
+/**
+ * What a letter is worth at each position, for WordleLetterColumns::score():
+ *   positions[i][c]  added to a word's score for letter c at position i
+ * Letters repeated within a word only score the first time, unless `isRepeatScored`.
+ */
+struct WordleLetterWeights {
+    uint32_t positions[LETTER_COUNT][ALPHABET_SIZE]{};
+    bool isRepeatScored{false};
+};
+
+/**
+ * The words of a select's range, copied once into columns the letter selectors all share:
+ *   letters[i][w]  letter index at position i of word w, one contiguous column per position
+ *   repeats[w]     bit i set when position i repeats a letter from earlier in word w
+ *   words[w]       the word itself, for ranking
+ * Counting and scoring are fixed-width passes down the columns, without branches or per-word
+ *  lookups into strings, so the compiler can vectorize them for the target it builds for.
+ */
+struct WordleLetterColumns {
+    vector<uint8_t> letters[LETTER_COUNT];
+    vector<uint8_t> repeats;
+    vector<const string*> words;
+
+    size_t size() const { return words.size(); }
+
+    // room for `maxWords` up front, so assign() never grows a column
+    void reserve(size_t maxWords) {
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            letters[i].reserve(maxWords);
+        }
+        repeats.reserve(maxWords);
+        words.reserve(maxWords);
+    }
+
+    template <typename IterType>
+    void assign(IterType begin, IterType end) {
+        words.clear();
+        for (auto wordIt = begin; wordIt != end; wordIt++) {
+            words.push_back(&*wordIt);
+        }
+        for (size_t i = 0; i < LETTER_COUNT; i++) {
+            letters[i].resize(words.size());
+        }
+        repeats.resize(words.size());
+        for (size_t w = 0; w < words.size(); w++) {
+            const string& word = *words[w];
+            uint32_t seen = 0;
+            uint8_t repeated = 0;
+            for (size_t i = 0; i < LETTER_COUNT; i++) {
+                uint32_t bit = uint32_t(1) << letterIndex(word[i]);
+                letters[i][w] = static_cast<uint8_t>(letterIndex(word[i]));
+                repeated |= (seen & bit) ? uint8_t(1 << i) : 0;
+                seen |= bit;
+            }
+            repeats[w] = repeated;
+        }
+    }
+
+    WordleLetterCounts count() const;
+    // outScores[w]: sum over word w's positions of weights.positions[i][letters[i][w]]
+    void score(const WordleLetterWeights& weights, vector<uint32_t>& outScores) const;
+};
 
 template <typename IterType>
 class MostCommonLetterWordleSelector : public WordleSelector<IterType> {
 public:
+    MostCommonLetterWordleSelector();
     string select(IterType begin, IterType end, size_t rangeSize, const vector<WordleKnown>& knowns, size_t guessNum) override;
+    void reset() override;
+    // Counts over the range given to the last select
+    const WordleLetterCounts& getLetterCounts() const { return m_counts; }
 protected:
     bool containsAllHints(const string& word) const;
     string getBestCandidate() const;
     void clearOldState();
     char getMostCommonLetter() const;
+    void updateCounts();
     void computeFrequencyMap();
-    void sortWordsByFrequency();
+    void rankWordsByFrequency();
+    // higher score first, then the first alphabetically, so a pick depends only on the candidates
+    bool isBetter(uint32_t w1, uint32_t w2) const;
     void printCandidates() const;
-    virtual void computeFrequencyMapInternal(unordered_map<char, size_t>& letterMap,
-                                             unordered_map<string, size_t>& wordScore) = 0;
+#if CREATE_SCORES_FILE == true
+    void writeScoresFile() const;
+#endif
+    // What each letter is worth this select, from m_counts and m_knowns
+    virtual void computeLetterWeights(WordleLetterWeights& weights) = 0;
 
     IterType m_iterBegin;
     IterType m_iterEnd;
-    unordered_map<char, size_t> m_frequencyMapLetter;
-    unordered_map<string, size_t> m_wordScore;
+    WordleLetterCounts m_counts;
+    // Candidate ranges only shrink within a game, so m_counts follows them by removing
+    //  the words that dropped out since the last select (CandidateIterator only)
+    bool m_hasCounts{false};
+    WordleBitset m_countedWords;
+    const vector<string>* m_countedWordList{nullptr};
+    WordleLetterColumns m_columns;
+    WordleLetterWeights m_weights;
+    vector<uint32_t> m_scores; // m_columns.words[w] scores m_scores[w]
+    bool m_isScoresFileGuess{false};
     vector<WordleKnown> m_knowns;
-    unordered_map<char, size_t> m_alphabetFrequencyMapLetter;
-    unordered_map<string, size_t> m_alphabetWordScore;
-    set<WordScore, WordScoreComp> m_sortedWords{};
+    // The best PRINT_GUESSES_SIZE of m_columns.words best first, only the best one unless tracing
+    array<uint32_t, PRINT_GUESSES_SIZE> m_ranked;
+    size_t m_numRanked{0};
 };
 
 template <typename IterType>
 class NaiveMostCommonLetterWordleSelector : public MostCommonLetterWordleSelector<IterType> {
+public:
+    using MostCommonLetterWordleSelector<IterType>::MostCommonLetterWordleSelector;
 protected:
-    void computeFrequencyMapInternal(unordered_map<char, size_t>& letterMap,
-                                     unordered_map<string, size_t>& wordScore) override;
+    void computeLetterWeights(WordleLetterWeights& weights) override;
 };
 
 template <typename IterType>
 class ImprovedMostCommonLetterWordleSelector : public MostCommonLetterWordleSelector<IterType> {
+public:
+    using MostCommonLetterWordleSelector<IterType>::MostCommonLetterWordleSelector;
 protected:
-    void computeFrequencyMapInternal(unordered_map<char, size_t>& letterMap,
-                                     unordered_map<string, size_t>& wordScore) override;
+    void computeLetterWeights(WordleLetterWeights& weights) override;
 };
 
 template <typename IterType>
 class PositionalLetterWordleSelector : public MostCommonLetterWordleSelector<IterType> {
+public:
+    using MostCommonLetterWordleSelector<IterType>::MostCommonLetterWordleSelector;
+    void reset() override;
 protected:
-    void computeFrequencyMapInternal(unordered_map<char, size_t>& unused_letterMap,
-                                     unordered_map<string, size_t>& wordScore) override;
-    void clearOldState();
+    void computeLetterWeights(WordleLetterWeights& weights) override;
 
     bool m_initialGuess{true};
-    vector<unordered_map<char, size_t>> m_positionLetterScores;
 };
 
 template <typename IterType>
 class FrequencyAndPositionalLetterWordleSelector : public PositionalLetterWordleSelector<IterType> {
+public:
+    using PositionalLetterWordleSelector<IterType>::PositionalLetterWordleSelector;
 protected:
-    void computeFrequencyMapInternal(unordered_map<char, size_t>& unused_letterMap,
-                                     unordered_map<string, size_t>& wordScore) override;
-    bool m_initialGuess{true};
-    vector<unordered_map<char, size_t>> m_positionLetterScores;
-    unordered_map<char, size_t> m_fullLetterMap;
+    void computeLetterWeights(WordleLetterWeights& weights) override;
+};
+
+/////////////////
+
+/**
+ * Picks the guess with the highest expected information over the remaining candidates:
+ *   H(g) = log2(n) - (1/n) * sum_p c_p*log2(c_p), c_p = #candidates giving pattern p
+ * Guesses come from the feedback matrix, optionally including non-candidate words from
+ *  the extended dictionary. Guess words are split across the shared thread pool for large searches.
+ */
+template <typename IterType>
+class EntropyWordleSelector : public WordleSelector<IterType> {
+public:
+    EntropyWordleSelector(bool useExtendedGuesses=true);
+    string select(IterType begin, IterType end, size_t rangeSize, const vector<WordleKnown>& knowns, size_t guessNum) override;
+protected:
+    void scoreGuesses(size_t guessBegin, size_t guessEnd);
+    bool isBetter(size_t guessIdx, size_t bestIdx) const;
+    // first guess at or after `guessIdx` hard mode allows, past the end if none
+    size_t nextAllowed(size_t guessIdx) const;
+    double getEntropy(size_t guessIdx) const;
+    void printCandidates();
+
+    const WordleFeedbackMatrix& m_matrix;
+    WordleThreadPool& m_pool;
+    vector<double> m_weightedLogs; // n*log2(n)
+    vector<size_t> m_answerIdxs;
+    vector<bool> m_isCandidate;
+    vector<double> m_scores;       // sum_p c_p*log2(c_p), lower is better
+    vector<size_t> m_ranked;       // printCandidates() scratch
+};
+
+/**
+ * Picks the guess whose largest feedback partition is smallest, bounding the worst case:
+ *   M(g) = max_p c_p, c_p = #candidates giving pattern p
+ * Ties go to the smaller sum_p c_p^2 (n times the expected candidates left), then to a candidate.
+ * Branch and bound against the best M found so far, shared by every pool task the guesses are split across:
+ *   - the all-black partition (candidates sharing no letter with g) is a lower bound on M(g), counted
+ *     with a few ANDs over per-letter answer masks; a guess it already puts over the bound is skipped
+ *   - otherwise a guess is dropped as soon as one partition outgrows the bound while counting
+ * Only guesses that tie the final M are counted in full, so the pick doesn't depend on the split.
+ * The opener is the same every game, it's searched once and kept across reset().
+ */
+template <typename IterType>
+class MinimaxWordleSelector : public WordleSelector<IterType> {
+public:
+    MinimaxWordleSelector();
+    string select(IterType begin, IterType end, size_t rangeSize, const vector<WordleKnown>& knowns, size_t guessNum) override;
+protected:
+    struct Score {
+        size_t guessIdx;
+        uint32_t maxPartition;
+        uint64_t sumSquares;
+        bool isCandidate;
+    };
+
+    void scoreGuesses(size_t guessBegin, size_t guessEnd, Score* outBest);
+    // candidates without any of `letters`, a 26-bit letter set
+    uint32_t countAllBlack(uint32_t letters) const;
+    static bool isBetter(const Score& score, const Score& best);
+    // first guess at or after `guessIdx` hard mode allows, past the end if none
+    size_t nextAllowed(size_t guessIdx) const;
+
+    const WordleFeedbackMatrix& m_matrix;
+    WordleThreadPool& m_pool;
+    size_t m_numBlocks;            // 64 answers per block
+    vector<uint64_t> m_letterBlocks; // [letter * m_numBlocks + block]: answers holding the letter
+    vector<uint32_t> m_guessLetters; // letter set of each guess
+    vector<size_t> m_answerIdxs;
+    vector<bool> m_isCandidate;
+    vector<uint64_t> m_candidateBlocks;
+    vector<size_t> m_liveBlocks;   // blocks holding a candidate
+    bool m_isBlackBounded{false};   // candidates dense enough for countAllBlack() to pay off
+    atomic<uint32_t> m_bound;      // smallest M(g) so far
+    vector<Score> m_bests;         // best per pool worker, merged after the search
+    Score m_opener{};
+    bool m_hasOpener{false};
 };
 
 //////////
@@ -127,6 +321,8 @@ enum class WordleSelectorType {
     ImprovedMostCommonLetter,
     PositionalLetter,
     FrequencyAndPositionalLetter,
+    Entropy,
+    Minimax,
 };
 
 template <typename IterType>
@@ -145,9 +341,13 @@ struct WordleSelectorFactory {
             return new PositionalLetterWordleSelector<IterType>();
         case WordleSelectorType::FrequencyAndPositionalLetter:
             return new FrequencyAndPositionalLetterWordleSelector<IterType>();
+        case WordleSelectorType::Entropy:
+            return new EntropyWordleSelector<IterType>();
+        case WordleSelectorType::Minimax:
+            return new MinimaxWordleSelector<IterType>();
         }
 
-        if (DEBUG) cerr << "Error: [selector] invalid selectorType" << endl;
+        cerr << "Error: [selector] invalid selectorType" << endl;
 
         throw;
     }
@@ -160,6 +360,8 @@ template class NaiveMostCommonLetterWordleSelector<SetIterator>;
 template class ImprovedMostCommonLetterWordleSelector<SetIterator>;
 template class PositionalLetterWordleSelector<SetIterator>;
 template class FrequencyAndPositionalLetterWordleSelector<SetIterator>;
+template class EntropyWordleSelector<SetIterator>;
+template class MinimaxWordleSelector<SetIterator>;
 
 template class RandomWordleSelector<ForwardIterator>;
 template class EnhancedRandomWordleSelector<ForwardIterator>;
@@ -168,3 +370,17 @@ template class NaiveMostCommonLetterWordleSelector<ForwardIterator>;
 template class ImprovedMostCommonLetterWordleSelector<ForwardIterator>;
 template class PositionalLetterWordleSelector<ForwardIterator>;
 template class FrequencyAndPositionalLetterWordleSelector<ForwardIterator>;
+template class EntropyWordleSelector<ForwardIterator>;
+template class MinimaxWordleSelector<ForwardIterator>;
+
+template class RandomWordleSelector<CandidateIterator>;
+template class EnhancedRandomWordleSelector<CandidateIterator>;
+template class MostCommonLetterWordleSelector<CandidateIterator>;
+template class NaiveMostCommonLetterWordleSelector<CandidateIterator>;
+template class ImprovedMostCommonLetterWordleSelector<CandidateIterator>;
+template class PositionalLetterWordleSelector<CandidateIterator>;
+template class FrequencyAndPositionalLetterWordleSelector<CandidateIterator>;
+template class EntropyWordleSelector<CandidateIterator>;
+template class MinimaxWordleSelector<CandidateIterator>;
+
+} // namespace WORDLE_NAMESPACE
@@ -3,10 +3,17 @@
 #include "wordle_buffer.h"
 #include "wordle_rules.h"
 
+#include <memory>
 #include <string>
+#include <vector>
+
+namespace WORDLE_NAMESPACE {
 
 using buf_ptr = std::shared_ptr<WordleBuffer>;
 
+class WordleStateCache;
+class WordleTranspositionTable;
+
 class WordleSolver {
 public:
     WordleSolver() = default;
@@ -15,8 +22,19 @@ public:
     virtual std::string makeSubsequentGuess(size_t numGuess, buf_ptr wb, size_t idx) = 0;
     virtual void processResult(const WordleGuess& guess) = 0;
     virtual size_t getNumCandidates() const = 0;
+    // Back to the state before the first guess, without reloading the dictionary
+    virtual void reset() = 0;
+    // Every guess reuses the hints revealed so far, see `WordleHardMode`
+    virtual void setHardMode(bool isHardMode) { m_isHardMode = isHardMode; }
+    // States and guesses shared by every solver of a sweep, set up the same way, see `WordleStateCache`.
+    // Solvers without one to reuse ignore it
+    virtual void setStateCache(std::shared_ptr<WordleStateCache> cache) {}
+    // Picks shared by every solver of a sweep using the same selector, see `WordleTranspositionTable`
+    virtual void setTranspositionTable(std::shared_ptr<WordleTranspositionTable> table) {}
+    bool isHardMode() const { return m_isHardMode; }
 protected:
     std::vector<WordleKnown> m_knownCorrects{LETTER_COUNT, {char(), WordleResult::BLACK}};
+    bool m_isHardMode{false};
 };
 
 class WordleSolverImpl : public WordleSolver {
@@ -27,6 +45,9 @@ public:
     std::string makeSubsequentGuess(size_t numGuess, buf_ptr wb, size_t idx) { return "guess"; }
     void processResult(const WordleGuess& guess) {}
     size_t getNumCandidates() const { return 0; }
+    void reset() { m_knownCorrects.assign(LETTER_COUNT, {char(), WordleResult::BLACK}); }
 protected:
     std::vector<WordleKnown> m_knownCorrects{LETTER_COUNT, {char(), WordleResult::BLACK}};
 };
+
+} // namespace WORDLE_NAMESPACE
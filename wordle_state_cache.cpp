@@ -0,0 +1,125 @@
+#include "wordle_state_cache.h"
+#include "wordle_candidates.h"
+#include "wordle_dictionary.h"
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+WordleStateCache::WordleStateCache(const WordleDictionary& answers, size_t maxDepth, size_t maxBytes)
+    : m_guesses(WordleDictionary::getGuesses()), m_maxDepth(min<size_t>(maxDepth, MAX_GUESSES - 1)) {
+    // bitset words and live-block summary, the guess and depth, two table slots
+    size_t numBlocks = (answers.size() + 63) / 64;
+    m_nodeBytes = sizeof(WordleCandidateSet) + (numBlocks + (numBlocks + 63) / 64) * sizeof(uint64_t) +
+                  sizeof(atomic<uint32_t>) + sizeof(uint8_t) + 2 * sizeof(Slot);
+    size_t capacity = max<size_t>(1, min(maxBytes / m_nodeBytes, answers.size() * m_maxDepth + 1));
+
+    m_states.assign(capacity, WordleCandidateSet(&answers.getWords()));
+    m_nodeGuesses = make_unique<atomic<uint32_t>[]>(capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        m_nodeGuesses[i].store(NO_NODE, memory_order_relaxed);
+    }
+    m_depths.assign(capacity, 0);
+    size_t numSlots = bit_ceil(2 * capacity);
+    m_slots = make_unique<Slot[]>(numSlots);
+    m_slotMask = numSlots - 1;
+}
+
+bool WordleStateCache::getGuess(uint32_t node, string& outGuess) {
+    m_guessLookups.fetch_add(1, memory_order_relaxed);
+    uint32_t guess = m_nodeGuesses[node].load(memory_order_acquire);
+    if (guess == NO_NODE) {
+        return false;
+    }
+    m_guessHits.fetch_add(1, memory_order_relaxed);
+    outGuess = m_guesses.getWord(guess);
+    return true;
+}
+
+void WordleStateCache::setGuess(uint32_t node, string_view guess) {
+    // racing solvers found the same guess from the same state, either store will do
+    size_t guessIdx;
+    if (m_guesses.getWordId(guess, guessIdx)) {
+        m_nodeGuesses[node].store(guessIdx, memory_order_release);
+    }
+}
+
+bool WordleStateCache::isGuess(uint32_t node, string_view guess) const {
+    uint32_t guessIdx = m_nodeGuesses[node].load(memory_order_acquire);
+    return guessIdx != NO_NODE && m_guesses.getWord(guessIdx) == guess;
+}
+
+uint32_t WordleStateCache::findChild(uint32_t node, feedback_t feedback) {
+    m_stateLookups.fetch_add(1, memory_order_relaxed);
+    uint64_t key = makeKey(node, feedback);
+    for (size_t i = 0, slot = ((key * 0x9E3779B97F4A7C15ull) >> 32) & m_slotMask; i <= m_slotMask; i++, slot = (slot + 1) & m_slotMask) {
+        uint64_t seen = m_slots[slot].key.load(memory_order_acquire);
+        if (seen == 0) {
+            return NO_NODE;
+        }
+        if (seen == key) {
+            uint32_t child = m_slots[slot].child.load(memory_order_acquire);
+            if (child != NO_NODE) {
+                m_stateHits.fetch_add(1, memory_order_relaxed);
+            }
+            return child;
+        }
+    }
+    return NO_NODE;
+}
+
+uint32_t WordleStateCache::addChild(uint32_t node, feedback_t feedback, const WordleCandidateSet& state) {
+    if (m_depths[node] >= m_maxDepth || m_numNodes.load(memory_order_relaxed) >= m_states.size()) {
+        return NO_NODE;
+    }
+
+    uint64_t key = makeKey(node, feedback);
+    for (size_t i = 0, slot = ((key * 0x9E3779B97F4A7C15ull) >> 32) & m_slotMask; i <= m_slotMask; i++, slot = (slot + 1) & m_slotMask) {
+        uint64_t seen = 0;
+        if (!m_slots[slot].key.compare_exchange_strong(seen, key, memory_order_acq_rel)) {
+            if (seen != key) {
+                continue;
+            }
+            // someone else claimed it, theirs if it's written by now
+            return m_slots[slot].child.load(memory_order_acquire);
+        }
+
+        uint32_t child = m_numNodes.fetch_add(1, memory_order_relaxed);
+        if (child >= m_states.size()) {
+            return NO_NODE;
+        }
+        // same size as every other state, the copy reuses the node's storage
+        m_states[child] = state;
+        m_depths[child] = m_depths[node] + 1;
+        m_slots[slot].child.store(child, memory_order_release);
+        return child;
+    }
+    return NO_NODE;
+}
+
+void WordleStateCache::print(ostream& os) const {
+    // solvers without a selector to skip never look anything up
+    if (m_guessLookups == 0 && m_stateLookups == 0) {
+        return;
+    }
+    auto percent = [](size_t hits, size_t lookups) {
+        return lookups ? 100.0 * static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    };
+    os << "state cache: " << getNumNodes() << "/" << getCapacity() << " states ("
+       << (getNumNodes() * m_nodeBytes) / 1024 << " KB), states reused: " << m_stateHits << "/" << m_stateLookups
+       << " (" << std::setprecision(4) << percent(m_stateHits, m_stateLookups) << "%), guesses reused: "
+       << m_guessHits << "/" << m_guessLookups << " (" << percent(m_guessHits, m_guessLookups) << "%)" << endl;
+}
+
+} // namespace WORDLE_NAMESPACE
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "wordle_candidates.h"
+#include "wordle_dictionary.h"
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+State Cache
+
+                  (root) all answers, guess: oater
+                /         |        \
+   feedback:  BBBBB     BBBBY  ..  GGGGB
+                |         |          |
+             state 1   state 2 ..  state k   candidates left + the guess played there
+              / ..\
+              ...
+
+Shared by every solver in a sweep: every game starts from the same state and guesses are
+ deterministic, so the state after a run of feedback, and the guess played from it, is the
+ same in every game that gets that feedback. The first game to reach a state records it, later
+ games copy its candidates instead of applying the constraint, and play its guess without
+ running the selector.
+
+Storage for every node is taken up front, whichever is smaller: STATE_CACHE_BYTES, or one node
+ per answer per level (each answer reaches one state per guess). Past that, or below `maxDepth`
+ guesses, games play uncached. Children are found through a fixed open-addressing table keyed
+ by (parent, feedback). Slots are claimed with a CAS and a node is published after its state is
+ written, so lookups never lock.
+ */
+class WordleStateCache {
+public:
+    static const uint32_t NO_NODE = UINT32_MAX;
+
+    WordleStateCache(const WordleDictionary& answers, size_t maxDepth=STATE_CACHE_DEPTH, size_t maxBytes=STATE_CACHE_BYTES);
+
+    uint32_t getRoot() const { return 0; }
+    // false until a solver has played from `node`
+    bool getGuess(uint32_t node, string& outGuess);
+    void setGuess(uint32_t node, string_view guess);
+    bool isGuess(uint32_t node, string_view guess) const;
+
+    // NO_NODE if nobody has recorded the state `feedback` leads to yet
+    uint32_t findChild(uint32_t node, feedback_t feedback);
+    // Records `state` as reached from `node` by `feedback`, NO_NODE if too deep, full, or another solver is recording it
+    uint32_t addChild(uint32_t node, feedback_t feedback, const WordleCandidateSet& state);
+    const WordleCandidateSet& getState(uint32_t node) const { return m_states[node]; }
+
+    size_t getNumNodes() const { return min<size_t>(m_numNodes.load(), m_states.size()); }
+    size_t getCapacity() const { return m_states.size(); }
+    // states and guesses reused out of those looked up, nodes and memory in use
+    void print(ostream& os=cout) const;
+private:
+    struct Slot {
+        atomic<uint64_t> key{0}; // 0 while free
+        atomic<uint32_t> child{NO_NODE}; // set once the child's state is written
+    };
+
+    static uint64_t makeKey(uint32_t node, feedback_t feedback) { return ((uint64_t(node) << 32) | feedback) + 1; }
+
+    const WordleDictionary& m_guesses; // guesses are kept as IDs into the extended list
+    size_t m_maxDepth;
+    size_t m_nodeBytes;
+    vector<WordleCandidateSet> m_states;
+    unique_ptr<atomic<uint32_t>[]> m_nodeGuesses;
+    vector<uint8_t> m_depths;
+    atomic<uint32_t> m_numNodes{1};
+    unique_ptr<Slot[]> m_slots;
+    size_t m_slotMask;
+
+    atomic<size_t> m_guessLookups{0};
+    atomic<size_t> m_guessHits{0};
+    atomic<size_t> m_stateLookups{0};
+    atomic<size_t> m_stateHits{0};
+};
+
+} // namespace WORDLE_NAMESPACE
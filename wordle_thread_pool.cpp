@@ -0,0 +1,141 @@
+#include "wordle_thread_pool.h"
+#include "wordle_rules.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+static thread_local bool t_isWorkerThread = false;
+// the sweeps deal 8 chunks per worker, more than that grows a queue once
+static const size_t POOL_QUEUE_CHUNKS = 16;
+
+WordleThreadPool::WordleThreadPool(size_t numWorkers) {
+    if (numWorkers == 0) {
+        numWorkers = thread::hardware_concurrency();
+    }
+    if (numWorkers == 0) {
+        numWorkers = 1;
+    }
+
+    for (size_t i = 0; i < numWorkers; i++) {
+        m_queues.push_back(make_unique<WorkQueue>());
+        m_queues.back()->chunks.reserve(POOL_QUEUE_CHUNKS);
+    }
+    for (size_t i = 0; i < numWorkers; i++) {
+        m_workers.push_back(thread(&WordleThreadPool::workerLoop, this, i));
+    }
+}
+
+WordleThreadPool::~WordleThreadPool() {
+    {
+        lock_guard<mutex> lck(m_mtx);
+        m_stop = true;
+    }
+    m_workCv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+bool WordleThreadPool::isWorkerThread() {
+    return t_isWorkerThread;
+}
+
+void WordleThreadPool::setWorkerThread() {
+    t_isWorkerThread = true;
+}
+
+WordleThreadPool& WordleThreadPool::getShared() {
+    static WordleThreadPool pool;
+    return pool;
+}
+
+void WordleThreadPool::run(size_t numItems, size_t chunkSize, const Task& task) {
+    if (numItems == 0) {
+        return;
+    }
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+
+    lock_guard<mutex> runLck(m_runMtx);
+    {
+        lock_guard<mutex> lck(m_mtx);
+        // the last run took every chunk, start the queues over
+        for (auto& queue : m_queues) {
+            lock_guard<mutex> queueLck(queue->mtx);
+            queue->chunks.clear();
+            queue->head = 0;
+        }
+        size_t queueIdx = 0;
+        for (size_t begin = 0; begin < numItems; begin += chunkSize) {
+            size_t end = (begin + chunkSize < numItems) ? begin + chunkSize : numItems;
+            lock_guard<mutex> queueLck(m_queues[queueIdx]->mtx);
+            m_queues[queueIdx]->chunks.push_back(Chunk{begin, end, &task});
+            queueIdx = (queueIdx + 1) % m_queues.size();
+            m_remaining++;
+        }
+        m_generation++;
+    }
+    m_workCv.notify_all();
+
+    unique_lock<mutex> lck(m_mtx);
+    m_doneCv.wait(lck, [this]() { return m_remaining == 0; });
+}
+
+void WordleThreadPool::workerLoop(size_t workerIdx) {
+    t_isWorkerThread = true;
+    size_t seenGeneration = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lck(m_mtx);
+            m_workCv.wait(lck, [&]() { return m_stop || m_generation != seenGeneration; });
+            if (m_stop) {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+
+        Chunk chunk;
+        while (popChunk(workerIdx, chunk)) {
+            (*chunk.task)(workerIdx, chunk.begin, chunk.end);
+
+            lock_guard<mutex> lck(m_mtx);
+            if (--m_remaining == 0) {
+                m_doneCv.notify_all();
+            }
+        }
+    }
+}
+
+bool WordleThreadPool::popChunk(size_t workerIdx, Chunk& outChunk) {
+    // own queue first, oldest chunk
+    {
+        auto& queue = *m_queues[workerIdx];
+        lock_guard<mutex> lck(queue.mtx);
+        if (queue.head < queue.chunks.size()) {
+            outChunk = queue.chunks[queue.head++];
+            return true;
+        }
+    }
+
+    // steal newest chunk from someone else
+    for (size_t i = 1; i < m_queues.size(); i++) {
+        auto& victim = *m_queues[(workerIdx + i) % m_queues.size()];
+        lock_guard<mutex> lck(victim.mtx);
+        if (victim.head < victim.chunks.size()) {
+            outChunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace WORDLE_NAMESPACE
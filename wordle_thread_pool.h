@@ -0,0 +1,70 @@
+#pragma once
+
+#include "wordle_rules.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+ * Fixed set of worker threads, sized to the hardware by default.
+ *
+ * `run` splits [0, numItems) into chunks and deals them out round-robin to one queue
+ *  per worker. Workers drain their own queue from the front and, once empty, steal
+ *  from the back of the other queues, so uneven games don't leave cores idle.
+ * Queues keep their storage between runs, so dealing chunks doesn't allocate once warm,
+ *  and one `run` at a time: callers on other threads wait their turn.
+ */
+class WordleThreadPool {
+public:
+    using Task = function<void(size_t workerIdx, size_t begin, size_t end)>;
+
+    WordleThreadPool(size_t numWorkers=0);
+    ~WordleThreadPool();
+
+    // Blocks until `task` has run over every chunk
+    void run(size_t numItems, size_t chunkSize, const Task& task);
+    size_t getNumWorkers() const { return m_workers.size(); }
+
+    // One worker per core, for work split inside a single call (a selector's guesses) rather than a sweep
+    static WordleThreadPool& getShared();
+
+    // true when called from inside a pool task, lets nested work stay single-threaded
+    static bool isWorkerThread();
+    // For threads outside any pool that already keep a core busy each, nested work stays single-threaded there too
+    static void setWorkerThread();
+private:
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        const Task* task;
+    };
+    struct WorkQueue {
+        mutex mtx;
+        vector<Chunk> chunks; // [head, end) not taken yet
+        size_t head{0};
+    };
+
+    void workerLoop(size_t workerIdx);
+    bool popChunk(size_t workerIdx, Chunk& outChunk);
+
+    vector<thread> m_workers;
+    vector<unique_ptr<WorkQueue>> m_queues;
+    mutex m_runMtx;
+    mutex m_mtx;
+    condition_variable m_workCv;
+    condition_variable m_doneCv;
+    size_t m_generation{0};
+    size_t m_remaining{0};
+    bool m_stop{false};
+};
+
+} // namespace WORDLE_NAMESPACE
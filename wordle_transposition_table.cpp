@@ -0,0 +1,102 @@
+#include "wordle_transposition_table.h"
+#include "wordle_candidates.h"
+#include "wordle_dictionary.h"
+#include "wordle_rules.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+WordleTranspositionTable::WordleTranspositionTable(size_t maxEntries, size_t numShards)
+    : m_guesses(WordleDictionary::getGuesses()), m_shards(max<size_t>(1, numShards)) {
+    m_numSets = max<size_t>(1, maxEntries / (m_shards.size() * NUM_WAYS));
+    for (auto& shard : m_shards) {
+        shard.entries.resize(m_numSets * NUM_WAYS);
+    }
+}
+
+WordleTranspositionTable::Key WordleTranspositionTable::makeKey(const WordleCandidateSet& candidates, const vector<WordleKnown>& knowns, size_t guessNum) {
+    // greens as base-27 digits (0 for none), then the guess number
+    uint64_t state = 0;
+    for (auto& known : knowns) {
+        state = state * 27 + (known.result == WordleResult::GREEN ? letterIndex(known.letter) + 1 : 0);
+    }
+    state = state * (MAX_GUESSES + 1) + guessNum;
+    return {candidates.hash(state * 0x9E3779B97F4A7C15ull), candidates.hash(~state * 0xC2B2AE3D27D4EB4Full)};
+}
+
+bool WordleTranspositionTable::find(const Key& key, string& outGuess) {
+    auto& shard = findShard(key);
+    uint32_t guess = NO_GUESS;
+    {
+        lock_guard<mutex> lck(shard.mtx);
+        Entry* ways = findSet(shard, key);
+        for (size_t w = 0; w < NUM_WAYS; w++) {
+            if (ways[w].guess != NO_GUESS && ways[w].hi == key.hi && ways[w].lo == key.lo) {
+                ways[w].lastUsed = ++shard.clock;
+                guess = ways[w].guess;
+                break;
+            }
+        }
+    }
+    if (guess == NO_GUESS) {
+        m_misses.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    m_hits.fetch_add(1, memory_order_relaxed);
+    outGuess = m_guesses.getWord(guess);
+    return true;
+}
+
+void WordleTranspositionTable::insert(const Key& key, string_view guess) {
+    size_t guessIdx;
+    if (!m_guesses.getWordId(guess, guessIdx)) {
+        return;
+    }
+
+    auto& shard = findShard(key);
+    lock_guard<mutex> lck(shard.mtx);
+    Entry* ways = findSet(shard, key);
+    // the same key again (two threads picked it at once), else a free way, else the least recently used
+    Entry* victim = &ways[0];
+    for (size_t w = 0; w < NUM_WAYS; w++) {
+        if (ways[w].guess != NO_GUESS && ways[w].hi == key.hi && ways[w].lo == key.lo) {
+            victim = &ways[w];
+            break;
+        }
+        if (victim->guess != NO_GUESS && (ways[w].guess == NO_GUESS || ways[w].lastUsed < victim->lastUsed)) {
+            victim = &ways[w];
+        }
+    }
+    if (victim->guess == NO_GUESS) {
+        shard.numUsed++;
+    } else if (victim->hi != key.hi || victim->lo != key.lo) {
+        m_evictions.fetch_add(1, memory_order_relaxed);
+    }
+    *victim = {key.hi, key.lo, static_cast<uint32_t>(guessIdx), ++shard.clock};
+}
+
+void WordleTranspositionTable::print(ostream& os) const {
+    size_t lookups = m_hits + m_misses;
+    // solvers without a selector to skip never look anything up
+    if (lookups == 0) {
+        return;
+    }
+    size_t numUsed = 0;
+    for (auto& shard : m_shards) {
+        numUsed += shard.numUsed;
+    }
+    os << "transposition table: " << numUsed << "/" << getCapacity() << " picks, reused: " << m_hits << "/" << lookups
+       << " (" << std::setprecision(4) << (100.0 * static_cast<double>(m_hits) / static_cast<double>(lookups)) << "%), dropped: "
+       << m_evictions << endl;
+}
+
+} // namespace WORDLE_NAMESPACE
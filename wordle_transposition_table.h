@@ -0,0 +1,82 @@
+#pragma once
+
+#include "wordle_candidates.h"
+#include "wordle_dictionary.h"
+#include "wordle_rules.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+namespace WORDLE_NAMESPACE {
+
+
+/**
+Transposition Table
+
+Picks already made, shared by every solver of a sweep. Games reach the same candidates by
+ different feedback, and a selector's pick depends only on the candidates, the greens known
+ and the guess number, so those three are fingerprinted (128 bits) and the pick is reused.
+
+   shard = hi % numShards   [ mutex | set 0: 4 ways | set 1: 4 ways | ... ]
+   set   = lo % numSets      way: {hi, lo, guess ID, last used}
+
+Sharded so threads rarely wait on the same lock. Storage is fixed up front, and a full set
+ drops its least recently used way.
+ */
+class WordleTranspositionTable {
+public:
+    static const size_t NUM_WAYS = 4;
+
+    struct Key {
+        uint64_t hi;
+        uint64_t lo;
+    };
+
+    WordleTranspositionTable(size_t maxEntries=TRANSPOSITION_ENTRIES, size_t numShards=TRANSPOSITION_SHARDS);
+
+    static Key makeKey(const WordleCandidateSet& candidates, const vector<WordleKnown>& knowns, size_t guessNum);
+    // false if not picked yet, or dropped since
+    bool find(const Key& key, string& outGuess);
+    void insert(const Key& key, string_view guess);
+
+    size_t getCapacity() const { return m_shards.size() * m_numSets * NUM_WAYS; }
+    // hits, misses and entries dropped to make room
+    void print(ostream& os=cout) const;
+private:
+    static const uint32_t NO_GUESS = UINT32_MAX;
+
+    struct Entry {
+        uint64_t hi{0};
+        uint64_t lo{0};
+        uint32_t guess{NO_GUESS}; // extended guess ID
+        uint32_t lastUsed{0};
+    };
+
+    struct alignas(64) Shard {
+        mutex mtx;
+        vector<Entry> entries; // numSets * NUM_WAYS, a set's ways contiguous
+        uint32_t clock{0};
+        size_t numUsed{0};
+    };
+
+    Entry* findSet(Shard& shard, const Key& key) { return &shard.entries[(key.lo % m_numSets) * NUM_WAYS]; }
+    Shard& findShard(const Key& key) { return m_shards[key.hi % m_shards.size()]; }
+
+    const WordleDictionary& m_guesses;
+    vector<Shard> m_shards;
+    size_t m_numSets;
+
+    atomic<size_t> m_hits{0};
+    atomic<size_t> m_misses{0};
+    atomic<size_t> m_evictions{0};
+};
+
+} // namespace WORDLE_NAMESPACE
@@ -1,175 +1,250 @@
 #include "wordlist_wordle_solver.h"
+#include "wordle_constraint.h"
 #include "wordle_helpers.h"
+#include "wordle_openers.h"
 #include "wordle_rules.h"
 #include "wordle_selector.h"
 #include "wordle_solver.h"
+#include "wordle_state_cache.h"
+#include "wordle_transposition_table.h"
 
 #include <algorithm>
-#include <fstream>
-#include <functional>
 #include <iostream>
-#include <random>
-#include <set>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 using namespace std;
 
+namespace WORDLE_NAMESPACE {
 
-WordlistWordleSolver::WordlistWordleSolver() : WordleSolverImpl() {
-    m_selector = WordleSelectorFactory<SetIterator>::makeWordleSelector(WordleSelectorType::FrequencyAndPositionalLetter); // Choose `WordleSelector` HERE!!
-    loadWordList([this](const string& word) -> void {
-        m_wordlist.push_back(word);
-        m_wordSet.insert(word);
-        for (size_t i = 0; i < LETTER_COUNT; i++) {
-            char curChar = word[i];
-            if (m_letterMaps[i].find(curChar) != m_letterMaps[i].end()) {
-                m_letterMaps[i][curChar].push_back(word);
-            } else {
-                m_letterMaps[i][curChar] = {word};
-            }
-        }
-    });
+
+WordlistWordleSolver::WordlistWordleSolver(WordleSelectorType selectorType)
+    : WordleSolverImpl(), m_selectorType(selectorType), m_dict(WordleDictionary::getAnswers()) {
+    m_selector = WordleSelectorFactory<CandidateIterator>::makeWordleSelector(selectorType);
+    m_wordSet = WordleCandidateSet(&m_dict.getWords());
 }
 
-void WordlistWordleSolver::loadWordList(function<void(string)> eachLineCallback) {
-    for (size_t i = 0; i < LETTER_COUNT; i++) {
-        m_letterMaps.push_back(unordered_map<char, vector<string>>{});
+void WordlistWordleSolver::reset() {
+    WordleSolverImpl::reset();
+    m_wordSet.reset();
+    m_selector->reset();
+    if (m_hardMode) {
+        m_hardMode->reset();
     }
+}
 
-    // src: https://raw.githubusercontent.com/printfn/wordle-dict/main/answers.txt
-    // src: https://raw.githubusercontent.com/AllValley/WordleDictionary/main/wordle_complete_dictionary.txt
-    auto filein = ifstream(DICTIONARY_FILENAME);
-    string word;
-    while (std::getline(filein, word)) {
-        eachLineCallback(word);
+void WordlistWordleSolver::setHardMode(bool isHardMode) {
+    WordleSolverImpl::setHardMode(isHardMode);
+    // over the extended guesses, a superset of every dictionary a selector guesses from
+    m_hardMode = isHardMode ? make_unique<WordleHardMode>(WordleDictionary::getGuesses()) : nullptr;
+    m_selector->setHardMode(m_hardMode.get());
+}
+
+void WordlistWordleSolver::updateHardMode(const WordleGuess& guess) {
+    if (m_hardMode) {
+        m_hardMode->addResult(WordleConstraint(guess));
     }
+}
 
-    if (DEBUG) cout << "Size of wordlist: " << m_wordlist.size() << endl;
+/////////////////////
+
+void PassthroughWordleSolver::processResult(const WordleGuess& guess) {
+    // nothing is ruled out, except guesses hard mode no longer allows (answer IDs match guess IDs)
+    if (m_hardMode) {
+        updateHardMode(guess);
+        m_wordSet.keepOnly(m_hardMode->getAllowed());
+    }
 }
 
 /////////////////////
 
-TrieBasedWordleSolver::TrieBasedWordleSolver() : PassthroughWordleSolver() {
-    m_selector = WordleSelectorFactory<SetIterator>::makeWordleSelector(WordleSelectorType::FrequencyAndPositionalLetter); // Choose `WordleSelector` HERE!!
-    m_trie = new WordleTrie();
-    loadWordList([this](const string& line){
-        m_trie->insert(line);
-    });
+TrieBasedWordleSolver::TrieBasedWordleSolver(WordleSelectorType selectorType)
+    : PassthroughWordleSolver(selectorType), m_cacheNode(WordleStateCache::NO_NODE) {
+    m_filter = new WordleCandidateFilter(m_dict);
+    // best opener from `--mode openers` for this selector, else the best 5-letter one found so far,
+    //  other lengths score one at startup
+    if (!WordleOpeners::getInstance().getBestFor(selectorType, m_opener) && LETTER_COUNT == 5) {
+        m_opener = "oater";
+    }
+}
+
+void TrieBasedWordleSolver::reset() {
+    PassthroughWordleSolver::reset();
+    m_filter->reset();
+    m_cacheNode = m_cache ? m_cache->getRoot() : WordleStateCache::NO_NODE;
+}
+
+void TrieBasedWordleSolver::setStateCache(shared_ptr<WordleStateCache> cache) {
+    // random picks differ game to game, nothing to share
+    m_cache = isRandom() ? nullptr : cache;
+    m_cacheNode = m_cache ? m_cache->getRoot() : WordleStateCache::NO_NODE;
+}
+
+void TrieBasedWordleSolver::setTranspositionTable(shared_ptr<WordleTranspositionTable> table) {
+    m_table = isRandom() ? nullptr : table;
+}
+
+string TrieBasedWordleSolver::selectCandidate(size_t guessNum) {
+    string candidateWord;
+    if (m_cacheNode != WordleStateCache::NO_NODE && m_cache->getGuess(m_cacheNode, candidateWord)) {
+        return candidateWord;
+    }
+
+    // hard mode picks also depend on the guesses still allowed, which the candidates don't show
+    auto key = WordleTranspositionTable::Key();
+    bool isKeyed = m_table && !m_hardMode;
+    if (isKeyed) {
+        key = WordleTranspositionTable::makeKey(m_filter->getCandidates(), m_knownCorrects, guessNum);
+    }
+    if (!isKeyed || !m_table->find(key, candidateWord)) {
+        candidateWord = m_filter->getCandidate(m_selector, m_knownCorrects, guessNum);
+        if (isKeyed) {
+            m_table->insert(key, candidateWord);
+        }
+    }
+    if (m_cacheNode != WordleStateCache::NO_NODE) {
+        m_cache->setGuess(m_cacheNode, candidateWord);
+    }
+    return candidateWord;
 }
 
 string TrieBasedWordleSolver::makeInitialGuess(buf_ptr wb, size_t idx) {
-    if (m_trie->getNumCandidates() > 0) {
-        string candidateWord = "oater"; //m_trie->getCandidate(m_selector, m_knownCorrects, 0);
+    if (m_filter->getNumCandidates() > 0) {
+        string candidateWord = m_opener;
+        if (candidateWord.empty()) {
+            candidateWord = selectCandidate(0);
+        } else if (m_cacheNode != WordleStateCache::NO_NODE) {
+            m_cache->setGuess(m_cacheNode, candidateWord);
+        }
         if (candidateWord.size() == 0) {
-            if (DEBUG) wb->write("Error: [solver] empty word", idx, /*newline=*/true);
+            wb->write("Error: [solver] empty word", idx, /*newline=*/true);
             throw;
         }
-        wb->write(to_string(m_trie->getNumCandidates()) + ",", idx);
+        wb->write(to_string(m_filter->getNumCandidates()) + ",", idx);
         return candidateWord;
     }
 
-    if (DEBUG) wb->write("Error: [solver] no more candidates", idx, /*newline=*/true);
+    wb->write("Error: [solver] no more candidates", idx, /*newline=*/true);
     throw;
 }
 
 string TrieBasedWordleSolver::makeSubsequentGuess(size_t numGuess, buf_ptr wb, size_t idx) {
-    if (m_trie->getNumCandidates() > 0) {
-        string candidateWord = m_trie->getCandidate(m_selector, m_knownCorrects, numGuess);
+    if (m_filter->getNumCandidates() > 0) {
+        string candidateWord = selectCandidate(numGuess);
         if (candidateWord.size() == 0) {
-            if (DEBUG) wb->write("Error: [solver] empty word", idx, /*newline=*/true);
+            wb->write("Error: [solver] empty word", idx, /*newline=*/true);
             throw;
         }
-        wb->write(to_string(m_trie->getNumCandidates()) + ",", idx);
+        wb->write(to_string(m_filter->getNumCandidates()) + ",", idx);
         return candidateWord;
     }
 
-    if (DEBUG) wb->write("Error: [solver] no more candidates", idx, /*newline=*/true);
+    wb->write("Error: [solver] no more candidates", idx, /*newline=*/true);
     throw;
 }
 
-void TrieBasedWordleSolver::printNumCands(const string& color) const {
-    if (DEBUG) {
-        string color_code;
-        string end_color_code = "\033[0m";
-        if (color == "green") {
-            color_code = "\033[0;32m";
-        } else if (color == "yellow") {
-            color_code = "\033[0;33m";
-        } else if (color == "black") {
-            color_code = "\033[0;30m";
-        }
-        cout << "numCandidates [" << color_code << color << end_color_code << "] done:" << m_trie->getNumCandidates() << endl;
+void TrieBasedWordleSolver::printNumCands(const string& label) const {
+    if (isLogging(WordleLogLevel::VERBOSE)) {
+        cout << "numCandidates [" << label << "] done:" << m_filter->getNumCandidates() << endl;
     }
 }
 
 void TrieBasedWordleSolver::processResult(const WordleGuess& guess) {
-    // most restrictive -> least restrictive
-    trimGreens(guess, createPositionVector(guess, WordleResult::GREEN));
-    printNumCands("green");
-    trimYellows(guess, createPositionVector(guess, WordleResult::YELLOW));
-    printNumCands("yellow");
-    trimBlacks(guess, createPositionVector(guess, WordleResult::BLACK));
-    printNumCands("black");
-#if PRINT_GUESSES == true
-    m_trie->getCandidate(m_selector, m_knownCorrects, 0);
-#endif
-}
-
-vector<size_t> TrieBasedWordleSolver::createPositionVector(const WordleGuess& allPositions, WordleResult wr) {
-    vector<size_t> positions;
-    for (size_t i = 0; i < allPositions.results.size(); i++) {
-        if (allPositions.results[i] == wr) {
-            positions.push_back(i);
-            if (wr == WordleResult::GREEN && m_knownCorrects[i].result != WordleResult::GREEN) {
-                m_knownCorrects[i].result = WordleResult::GREEN;
-                m_knownCorrects[i].letter = allPositions.guessStr[i];
-            }
+    // whole feedback compiled to one constraint, applied in a single pass over the candidates
+    updateKnownCorrects(guess);
+    auto constraint = WordleConstraint(guess);
+    // a state another game already reached is copied, the guess played must be the one recorded
+    if (m_cacheNode != WordleStateCache::NO_NODE && m_cache->isGuess(m_cacheNode, guess.guessStr)) {
+        feedback_t feedback = encodeFeedback(guess.results);
+        uint32_t child = m_cache->findChild(m_cacheNode, feedback);
+        if (child != WordleStateCache::NO_NODE) {
+            m_filter->setCandidates(m_cache->getState(child));
+        } else {
+            m_filter->applyConstraint(constraint);
+            child = m_cache->addChild(m_cacheNode, feedback, m_filter->getCandidates());
         }
+        m_cacheNode = child;
+    } else {
+        m_cacheNode = WordleStateCache::NO_NODE;
+        m_filter->applyConstraint(constraint);
+    }
+    if (m_hardMode) {
+        m_hardMode->addResult(constraint);
+    }
+    printNumCands("constraint");
+    // only what's left: ranking it here would run the selector an extra time and shift its state
+    if (isLogging(WordleLogLevel::TRACE)) {
+        m_filter->printCandidates();
     }
-
-    return positions;
 }
 
-void TrieBasedWordleSolver::trimGreens(const WordleGuess& g, const vector<size_t>& positions) {
-    for (auto& p : positions) {
-        m_trie->fixupGreen(p, g.guessStr[p]);
+void TrieBasedWordleSolver::updateKnownCorrects(const WordleGuess& guess) {
+    for (size_t i = 0; i < guess.results.size(); i++) {
+        if (guess.results[i] == WordleResult::GREEN && m_knownCorrects[i].result != WordleResult::GREEN) {
+            m_knownCorrects[i].result = WordleResult::GREEN;
+            m_knownCorrects[i].letter = guess.guessStr[i];
+        }
     }
 }
 
-void TrieBasedWordleSolver::trimYellows(const WordleGuess& g, const vector<size_t>& positions) {
-    for (auto& p : positions) {
-        m_trie->fixupYellow(p, g.guessStr[p]);
-    }
+/////////////////////
+
+DecisionTreeWordleSolver::DecisionTreeWordleSolver(WordleSelectorType fallbackSelectorType)
+    : WordlistWordleSolver(fallbackSelectorType), m_tree(WordleDecisionTree::getInstance()),
+      m_matrix(WordleFeedbackMatrix::getExtendedMatrix()), m_node(m_tree.getRoot()) {}
+
+void DecisionTreeWordleSolver::reset() {
+    WordlistWordleSolver::reset();
+    m_node = m_tree.getRoot();
 }
 
-void TrieBasedWordleSolver::trimBlacks(const WordleGuess& g, const vector<size_t>& positions) {
-    for (auto& p : positions) {
-        if (countOccurs(g.guessStr[p], g.guessStr) > 1) {
-            if (isAnotherOccurrenceNotBlack(p, g)) {
-                // only remove letter for current slot
-                m_trie->fixupYellow(p, g.guessStr[p]);
-            } else {
-                // remove letter from all slots
-                m_trie->fixupBlack(p, g.guessStr[p]);
-            }
-        } else {
-            m_trie->fixupBlack(p, g.guessStr[p]);
-        }
+string DecisionTreeWordleSolver::makeGuess(size_t guessNum, buf_ptr wb, size_t idx) {
+    if (m_wordSet.size() == 0) {
+        wb->write("Error: [solver] no more candidates", idx, /*newline=*/true);
+        throw;
+    }
+
+    wb->write(to_string(m_wordSet.size()) + ",", idx);
+    // the tree wasn't searched for hard mode, leave it at the first guess that breaks the rules
+    if (m_node != WordleDecisionTree::NO_NODE && m_hardMode && !m_hardMode->isAllowed(m_tree.getGuessId(m_node))) {
+        m_node = WordleDecisionTree::NO_NODE;
+    }
+    if (m_node != WordleDecisionTree::NO_NODE) {
+        return m_tree.getGuess(m_node);
     }
+    return m_selector->select(m_wordSet.begin(), m_wordSet.end(), m_wordSet.size(), m_knownCorrects, guessNum);
 }
 
-bool TrieBasedWordleSolver::isAnotherOccurrenceNotBlack(size_t position, const WordleGuess& g) const {
-    char letter = g.guessStr[position];
-    for (size_t i = 0; i < g.guessStr.size(); i++) {
-        if (i == position) continue;
-        if (g.guessStr[i] == letter) {
-            if (g.results[i] != WordleResult::BLACK) {
-                return true;
-            }
+void DecisionTreeWordleSolver::processResult(const WordleGuess& guess) {
+    feedback_t feedback = encodeFeedback(guess.results);
+    updateHardMode(guess);
+
+    // drop answers that would have given different feedback
+    size_t guessIdx;
+    bool isKnownGuess = m_matrix.getGuessIndex(guess.guessStr, guessIdx);
+    for (auto it = m_wordSet.begin(); it != m_wordSet.end(); it++) {
+        size_t answerIdx = it.getWordId();
+        feedback_t answerFeedback = isKnownGuess ? m_matrix.lookup(guessIdx, answerIdx)
+                                                 : computeFeedback(guess.guessStr, m_dict.getLetters(answerIdx));
+        if (answerFeedback != feedback) {
+            m_wordSet.erase(answerIdx);
         }
     }
 
-    return false;
+    if (m_node != WordleDecisionTree::NO_NODE && isKnownGuess && m_tree.getGuessId(m_node) == guessIdx) {
+        m_node = m_tree.findChild(m_node, feedback);
+    } else {
+        m_node = WordleDecisionTree::NO_NODE;
+    }
+
+    // off the tree, the next select() ranks the candidates itself
+    if (isLogging(WordleLogLevel::TRACE)) {
+        if (m_node != WordleDecisionTree::NO_NODE) {
+            cout << "Tree guess: " << m_tree.getGuess(m_node) << " (" << m_wordSet.size() << " candidates)" << endl;
+        } else if (m_wordSet.size() > 0) {
+            cout << "Off tree: (" << m_wordSet.size() << " candidates)" << endl;
+        }
+    }
 }
+
+} // namespace WORDLE_NAMESPACE
@@ -1,33 +1,40 @@
 #pragma once
 
+#include "wordle_candidate_filter.h"
+#include "wordle_candidates.h"
+#include "wordle_decision_tree.h"
+#include "wordle_dictionary.h"
+#include "wordle_feedback.h"
+#include "wordle_hard_mode.h"
 #include "wordle_rules.h"
 #include "wordle_selector.h"
 #include "wordle_solver.h"
-#include "wordle_trie.h"
 
-#include <functional>
-#include <set>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 using namespace std;
+
+namespace WORDLE_NAMESPACE {
 using buf_ptr = shared_ptr<WordleBuffer>;
 
 class WordlistWordleSolver : public WordleSolverImpl {
 public:
     using WordleSolverImpl::WordleSolverImpl;
-    WordlistWordleSolver();
-    size_t getNumCandidates() const override { return m_wordlist.size(); }
+    WordlistWordleSolver(WordleSelectorType selectorType=WordleSelectorType::FrequencyAndPositionalLetter);
+    ~WordlistWordleSolver() { delete m_selector; }
+    size_t getNumCandidates() const override { return m_dict.size(); }
+    void reset() override;
+    void setHardMode(bool isHardMode) override;
 protected:
-    void loadWordList(function<void(string)> eachLineCallbackActor);
+    // hard mode only: narrows the allowed guesses, call with every result
+    void updateHardMode(const WordleGuess& guess);
 
-    WordleSelector<SetIterator>* m_selector;
-    vector<string> m_wordlist;
-    set<string> m_wordSet;
-    vector<
-        unordered_map<char, vector<string>>
-        > m_letterMaps;
+    WordleSelectorType m_selectorType;
+    WordleSelector<CandidateIterator>* m_selector;
+    const WordleDictionary& m_dict;
+    WordleCandidateSet m_wordSet;
+    unique_ptr<WordleHardMode> m_hardMode; // set in hard mode only
 };
 
 /////////////////////
@@ -39,42 +46,65 @@ public:
         return m_selector->select(m_wordSet.begin(), m_wordSet.end(), m_wordSet.size(), m_knownCorrects, 0);
     }
     string makeSubsequentGuess(size_t guessNum, buf_ptr wb, size_t idx) override { return m_selector->select(m_wordSet.begin(), m_wordSet.end(), m_wordSet.size(), m_knownCorrects, guessNum); }
-    void processResult(const WordleGuess& guess) override {}
+    void processResult(const WordleGuess& guess) override;
 };
 
 //////////////////
 
 /**
-Word Trie
-                             (root)
-                            /  | ..  \
-                         /     |   ..  \
-                      /        |    ..   \
-1st letter:          a         b     ..    z
-                   / | \     / | \       / | \
-2nd letter:      b   c  z   a  e  y     e  i  o
-
-...
-
-5th letter:      ...
-
+ * Narrows the answers with every result through a `WordleCandidateFilter`, the selector
+ *  only ever sees words consistent with all feedback so far.
  */
-
 class TrieBasedWordleSolver : public PassthroughWordleSolver {
 public:
     using PassthroughWordleSolver::PassthroughWordleSolver;
-    TrieBasedWordleSolver();
+    TrieBasedWordleSolver(WordleSelectorType selectorType=WordleSelectorType::FrequencyAndPositionalLetter);
     string makeInitialGuess(buf_ptr wb, size_t idx) override;
     string makeSubsequentGuess(size_t guessNum, buf_ptr wb, size_t idx) override;
     void processResult(const WordleGuess& guess) override;
-    size_t getNumCandidates() const override { return m_trie->getNumCandidates(); }
+    ~TrieBasedWordleSolver() { delete m_filter; }
+    size_t getNumCandidates() const override { return m_filter->getNumCandidates(); }
+    void reset() override;
+    // Every game opens with `word`, empty to let the selector pick
+    void setOpener(const string& word) { m_opener = word; }
+    void setStateCache(shared_ptr<WordleStateCache> cache) override;
+    void setTranspositionTable(shared_ptr<WordleTranspositionTable> table) override;
 protected:
-    vector<size_t> createPositionVector(const WordleGuess& allPositions, WordleResult wr);
-    bool isAnotherOccurrenceNotBlack(size_t position, const WordleGuess& g) const;
-    void printNumCands(const string& color) const;
-    void trimGreens(const WordleGuess& g, const vector<size_t>& positions);
-    void trimYellows(const WordleGuess& g, const vector<size_t>& positions);
-    void trimBlacks(const WordleGuess& g, const vector<size_t>& positions);
+    void updateKnownCorrects(const WordleGuess& guess);
+    void printNumCands(const string& label) const;
+    // the selector's pick, or the one already made from this state or these candidates
+    string selectCandidate(size_t guessNum);
+    bool isRandom() const { return m_selectorType == WordleSelectorType::Random || m_selectorType == WordleSelectorType::EnhancedRandom; }
 
-    WordleTrie* m_trie;
+    WordleCandidateFilter* m_filter;
+    string m_opener;
+    shared_ptr<WordleStateCache> m_cache;
+    shared_ptr<WordleTranspositionTable> m_table;
+    uint32_t m_cacheNode; // state reached in m_cache, WordleStateCache::NO_NODE once off it
 };
+
+//////////////////
+
+/**
+ * Plays the precomputed `WordleDecisionTree`: every guess is one child lookup keyed by the
+ *  feedback pattern, no scoring at runtime.
+ * Still tracks the answers consistent with every result, so once play leaves the tree
+ *  (own guesses in cheat mode, feedback the tree never saw) the selector takes over.
+ */
+class DecisionTreeWordleSolver : public WordlistWordleSolver {
+public:
+    DecisionTreeWordleSolver(WordleSelectorType fallbackSelectorType=WordleSelectorType::Entropy);
+    string makeInitialGuess(buf_ptr wb, size_t idx) override { return makeGuess(0, wb, idx); }
+    string makeSubsequentGuess(size_t guessNum, buf_ptr wb, size_t idx) override { return makeGuess(guessNum, wb, idx); }
+    void processResult(const WordleGuess& guess) override;
+    size_t getNumCandidates() const override { return m_wordSet.size(); }
+    void reset() override;
+protected:
+    string makeGuess(size_t guessNum, buf_ptr wb, size_t idx);
+
+    const WordleDecisionTree& m_tree;
+    const WordleFeedbackMatrix& m_matrix;
+    uint32_t m_node;
+};
+
+} // namespace WORDLE_NAMESPACE